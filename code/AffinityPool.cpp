@@ -0,0 +1,427 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "AffinityPool.hpp"
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+        // Nodes are referred to by index+1, so that 0 means "none".
+    const sql::uint32 none = 0;
+
+        // Distinguishes pools, even when one is allocated where another
+        // used to be.
+    std::atomic<sql::uint64> identities(0);
+
+        // Live pools, so that exiting threads can find theirs.
+    std::mutex& registry ()
+    {
+        static std::mutex mutex;
+        return (mutex);
+    }
+
+    std::map<sql::uint64, sql::AffinityPool*>& pools ()
+    {
+        static std::map<sql::uint64, sql::AffinityPool*> pools;
+        return (pools);
+    }
+
+        // Cache of the calling thread in each pool, if any.
+    struct Affinity
+    {
+        sql::uint64 pool;
+        sql::uint32 shelf;
+    };
+
+        // Hands the calling thread's caches back when it exits.
+    struct Affinities
+    {
+        std::vector<Affinity> known;
+
+        ~Affinities ()
+        {
+            const std::lock_guard<std::mutex> lock(::registry());
+            for (std::size_t i = 0; (i < known.size()); ++i)
+            {
+                const std::map<sql::uint64, sql::AffinityPool*>::iterator
+                    match = ::pools().find(known[i].pool);
+                if ((match != ::pools().end()) && (known[i].shelf != none)) {
+                    match->second->vacate(known[i].shelf);
+                }
+            }
+        }
+    };
+    thread_local Affinities affinities;
+
+}
+
+namespace sql {
+
+    void AffinityPool::Stack::push (Node * nodes, uint32 index)
+    {
+        uint64 head = myHead.load();
+        uint64 next = 0;
+        do {
+            nodes[index-1].next.store(static_cast<uint32>(head));
+            next = (((head >> 32)+1) << 32) | index;
+        }
+        while (!myHead.compare_exchange_weak(head, next));
+    }
+
+    uint32 AffinityPool::Stack::pop (Node * nodes)
+    {
+            // The tag changes on every update, so a node that was popped
+            // and pushed back in the meantime fails the exchange.
+        uint64 head = myHead.load();
+        while (static_cast<uint32>(head) != none)
+        {
+            const uint32 index = static_cast<uint32>(head);
+            const uint64 next = (((head >> 32)+1) << 32)
+                | nodes[index-1].next.load();
+            if (myHead.compare_exchange_weak(head, next)) {
+                return (index);
+            }
+        }
+        return (none);
+    }
+
+    AffinityPool::AffinityPool (ConnectionPool& pool,
+                                size_t cached, size_t threads)
+        : myPool(pool)
+        , myIdentity(++::identities)
+        , myRecycle(30)
+        , myNodes(new Node[pool.maximum()])
+        , myFree()
+        , myIdle()
+        , myThreads(static_cast<uint32>(threads))
+        , myCached(static_cast<uint32>(std::max<size_t>(cached, 1)))
+        , myStride(((myCached+15) / 16) * 16)
+        , mySlots(new std::atomic<uint32>[myThreads*myStride])
+        , myShelves(0)
+        , myMutex()
+        , myVacant()
+        , myWaiting(0)
+    {
+        for (uint32 i = 0; (i < myThreads*myStride); ++i) {
+            mySlots[i].store(none);
+        }
+        for (size_t i = pool.maximum(); (i > 0); --i) {
+            myFree.push(myNodes.get(), static_cast<uint32>(i));
+        }
+        const std::lock_guard<std::mutex> lock(::registry());
+        ::pools()[myIdentity] = this;
+    }
+
+    AffinityPool::~AffinityPool ()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(::registry());
+            ::pools().erase(myIdentity);
+        }
+            // Destroying the nodes returns their leases.
+    }
+
+    AffinityPool::Lease AffinityPool::acquire ()
+    {
+        Lease lease;
+        if (try_acquire(lease)) {
+            return (lease);
+        }
+
+            // From now on, connections are returned to the underlying pool,
+            // whose condition variable wakes this thread.  Check again for
+            // those cached before others noticed.
+        ++myWaiting;
+        try {
+            if (!try_acquire(lease))
+            {
+                ConnectionPool::Lease underlying = myPool.acquire();
+                lease.myPool = this, lease.myIndex = wrap(underlying);
+                lease.myBroken = false;
+            }
+        }
+        catch ( ... ) {
+            --myWaiting;
+            throw;
+        }
+        --myWaiting;
+        return (lease);
+    }
+
+    bool AffinityPool::try_acquire (Lease& lease)
+    {
+        lease.release();
+        std::atomic<uint32> *const mine = shelf();
+        const Clock::duration recycle = std::chrono::seconds(myRecycle.load());
+        for (uint32 index = take(mine); (index != none); index = take(mine))
+        {
+            if (Clock::now()-myNodes[index-1].leased < recycle) {
+                lease.myPool = this, lease.myIndex = index;
+                lease.myBroken = false;
+                return (true);
+            }
+            give_back(index);
+        }
+
+            // Everything missed: go to the underlying pool.
+        ConnectionPool::Lease underlying;
+        if (!myPool.try_acquire(underlying)) {
+            return (false);
+        }
+        lease.myPool = this, lease.myIndex = wrap(underlying);
+        lease.myBroken = false;
+        return (true);
+    }
+
+    void AffinityPool::recycle (uint32 seconds)
+    {
+        myRecycle.store(seconds);
+    }
+
+    void AffinityPool::vacate (uint32 shelf) throw()
+    {
+        std::atomic<uint32> *const slots = &mySlots[(shelf-1)*myStride];
+        for (uint32 i = 0; (i < myCached); ++i)
+        {
+            const uint32 index = slots[i].exchange(none);
+            if (index == none) {
+                continue;
+            }
+            if (myWaiting.load() > 0) {
+                give_back(index);
+            }
+            else {
+                keep(index, 0);
+            }
+        }
+        try {
+            const std::lock_guard<std::mutex> lock(myMutex);
+            myVacant.push_back(shelf);
+        }
+        catch ( ... ) {
+                // The cache is lost, but its connections are not.
+        }
+    }
+
+    std::atomic<uint32> * AffinityPool::shelf ()
+    {
+        std::vector<Affinity>& known = ::affinities.known;
+        for (std::size_t i = 0; (i < known.size()); ++i)
+        {
+            if (known[i].pool == myIdentity) {
+                return ((known[i].shelf == none)? 0 :
+                        &mySlots[(known[i].shelf-1)*myStride]);
+            }
+        }
+
+            // First visit from this thread: claim a cache, if any is left.
+        uint32 shelf = none;
+        {
+            const std::lock_guard<std::mutex> lock(myMutex);
+            if (!myVacant.empty()) {
+                shelf = myVacant.back(), myVacant.pop_back();
+            }
+        }
+        if ((shelf == none) && (myShelves.load() < myThreads))
+        {
+            const uint32 next = myShelves.fetch_add(1);
+            if (next < myThreads) {
+                shelf = next+1;
+            }
+        }
+        const Affinity affinity = { myIdentity, shelf };
+        known.push_back(affinity);
+        return ((shelf == none)? 0 : &mySlots[(shelf-1)*myStride]);
+    }
+
+    uint32 AffinityPool::take (std::atomic<uint32> * mine)
+    {
+        if (mine != 0)
+        {
+            for (uint32 i = 0; (i < myCached); ++i)
+            {
+                const uint32 index = mine[i].exchange(none);
+                if (index != none) {
+                    return (index);
+                }
+            }
+        }
+        const uint32 index = myIdle.pop(myNodes.get());
+        if (index != none) {
+            return (index);
+        }
+
+            // Steal from other threads, starting after this one's cache to
+            // spread thieves over the victims.
+        const uint32 count = std::min(myShelves.load(), myThreads);
+        const uint32 start = (mine == 0)? 0 :
+            static_cast<uint32>((mine-mySlots.get()) / myStride) + 1;
+        for (uint32 i = 0; (i < count); ++i)
+        {
+            std::atomic<uint32> *const victim =
+                &mySlots[((start+i) % count)*myStride];
+            if (victim == mine) {
+                continue;
+            }
+            for (uint32 j = 0; (j < myCached); ++j)
+            {
+                    // Read first, to avoid writing to other threads' cache
+                    // lines for nothing.
+                if (victim[j].load(std::memory_order_relaxed) == none) {
+                    continue;
+                }
+                const uint32 index = victim[j].exchange(none);
+                if (index != none) {
+                    return (index);
+                }
+            }
+        }
+        return (none);
+    }
+
+    uint32 AffinityPool::wrap (ConnectionPool::Lease& lease)
+    {
+        const uint32 index = myFree.pop(myNodes.get());
+        if (index == none) {
+            throw (std::logic_error(
+                "sql::AffinityPool: more connections than the pool's maximum."
+                ));
+        }
+        Node& node = myNodes[index-1];
+        node.lease = std::move(lease);
+        node.leased = Clock::now();
+        return (index);
+    }
+
+    void AffinityPool::give_back (uint32 index)
+    {
+            // Free the node first: a thread woken by the underlying pool
+            // needs one.
+        ConnectionPool::Lease lease(std::move(myNodes[index-1].lease));
+        myFree.push(myNodes.get(), index);
+        lease.release();
+    }
+
+    void AffinityPool::release (uint32 index, bool discard)
+    {
+        if (discard) {
+            myNodes[index-1].lease.discard();
+        }
+        if (discard || (myWaiting.load() > 0)) {
+            give_back(index);
+        }
+        else {
+            keep(index, shelf());
+        }
+    }
+
+    void AffinityPool::keep (uint32 index, std::atomic<uint32> * mine)
+    {
+            // Keep it in this thread's cache, else share it.
+        bool cached = false;
+        for (uint32 i = 0; (mine != 0) && !cached && (i < myCached); ++i)
+        {
+            uint32 expected = none;
+            cached = mine[i].compare_exchange_strong(expected, index);
+        }
+        if (!cached) {
+            myIdle.push(myNodes.get(), index);
+        }
+
+            // A thread that started waiting in the meantime may have missed
+            // it: hand one to the underlying pool, which wakes it up.
+        if (myWaiting.load() > 0)
+        {
+            const uint32 other = take(mine);
+            if (other != none) {
+                give_back(other);
+            }
+        }
+    }
+
+    AffinityPool::Lease::Lease ()
+        : myPool(0), myIndex(none), myBroken(false)
+    {
+    }
+
+    AffinityPool::Lease::Lease (Lease&& other)
+        : myPool(other.myPool), myIndex(other.myIndex)
+        , myBroken(other.myBroken)
+    {
+        other.myPool = 0;
+    }
+
+    AffinityPool::Lease::~Lease ()
+    {
+        release();
+    }
+
+    bool AffinityPool::Lease::valid () const
+    {
+        return (myPool != 0);
+    }
+
+    Connection& AffinityPool::Lease::connection () const
+    {
+        if (myPool == 0) {
+            throw (std::logic_error(
+                "sql::AffinityPool::Lease: no connection."
+                ));
+        }
+        return (myPool->myNodes[myIndex-1].lease.connection());
+    }
+
+    void AffinityPool::Lease::discard ()
+    {
+        myBroken = true;
+    }
+
+    void AffinityPool::Lease::release ()
+    {
+        if (myPool != 0)
+        {
+            AffinityPool *const pool = myPool;
+            myPool = 0;
+            pool->release(myIndex, myBroken);
+        }
+    }
+
+    AffinityPool::Lease& AffinityPool::Lease::operator= (Lease&& other)
+    {
+        if (&other != this)
+        {
+            release();
+            myPool = other.myPool, myIndex = other.myIndex;
+            myBroken = other.myBroken;
+            other.myPool = 0;
+        }
+        return (*this);
+    }
+
+}
@@ -0,0 +1,252 @@
+#ifndef _sql_AffinityPool_hpp__
+#define _sql_AffinityPool_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+#include "types.hpp"
+#include "ConnectionPool.hpp"
+#include "NotCopyable.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sql {
+
+    class Connection;
+
+    /*!
+     * @brief Connection pool front end that keeps connections near threads.
+     *
+     * Under heavy concurrency, the single lock of a @c ConnectionPool
+     * becomes a bottleneck.  This front end leases connections from such a
+     * pool and, when they are returned, keeps them instead:
+     *
+     * - first in a small cache owned by the returning thread, which gets
+     *   them back on its next checkout;
+     * - then on a lock-free stack shared by all threads;
+     * - and when the stack runs dry, threads steal idle connections from
+     *   other threads' caches.
+     *
+     * Only when all of these miss is the underlying pool locked, so checkout
+     * and return cost stays flat as threads are added.  A thread's cache is
+     * emptied when the thread exits, and handed to the next new thread.
+     * While threads wait for a connection, returned connections go straight
+     * back to the underlying pool, which wakes them up.
+     *
+     * Connections go back to the underlying pool once @c recycle() seconds
+     * have passed since they were leased from it, so that its validation
+     * and lifetime policies still apply.  All connections of the pool should
+     * be leased through this front end, and all leases must be returned
+     * before it is destroyed.
+     *
+     * @code
+     *  sql::ConnectionPool shared(factory, 8, 64);
+     *  sql::AffinityPool pool(shared);
+     *  // ...
+     *  sql::AffinityPool::Lease lease = pool.acquire();
+     *  sql::execute(*lease, "delete from sessions;");
+     * @endcode
+     */
+    class AffinityPool :
+        private NotCopyable
+    {
+        /* nested types. */
+    public:
+        typedef ConnectionPool::Clock Clock;
+
+        class Lease;
+
+    private:
+        struct Node
+        {
+            ConnectionPool::Lease lease;
+            Clock::time_point leased;
+            std::atomic<uint32> next;
+        };
+
+            // Lock-free stack of nodes, with a tag against ABA.
+        class Stack
+        {
+            std::atomic<uint64> myHead;
+        public:
+            Stack () : myHead(0) {}
+            void push (Node * nodes, uint32 index);
+            uint32 pop (Node * nodes);
+        };
+
+        /* data. */
+    private:
+        ConnectionPool& myPool;
+        uint64 myIdentity;
+        std::atomic<uint32> myRecycle;
+
+            // One node per connection the underlying pool may open.
+        std::unique_ptr<Node[]> myNodes;
+        Stack myFree;
+        Stack myIdle;
+
+            // Per-thread caches, each on its own cache line(s).
+        uint32 myThreads;
+        uint32 myCached;
+        uint32 myStride;
+        std::unique_ptr< std::atomic<uint32>[] > mySlots;
+        std::atomic<uint32> myShelves;
+
+            // Caches left behind by threads that exited.
+        std::mutex myMutex;
+        std::vector<uint32> myVacant;
+
+            // Threads waiting on the underlying pool.
+        std::atomic<uint32> myWaiting;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Lease connections from @a pool.
+         * @param pool Underlying pool, which must outlive this object.
+         * @param cached Connections kept in each thread's cache.
+         * @param threads Number of threads that get a cache.  Others share
+         *  the lock-free stack only.
+         */
+        explicit AffinityPool (ConnectionPool& pool, size_t cached=2,
+                               size_t threads=256);
+
+        /*!
+         * @brief Return all cached connections to the underlying pool.
+         */
+        ~AffinityPool ();
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Lease a connection, waiting for one if needed.
+         */
+        Lease acquire ();
+
+        /*!
+         * @brief Lease a connection without waiting.
+         * @return @c false if all connections are in use.
+         */
+        bool try_acquire (Lease& lease);
+
+        /*!
+         * @brief Return connections to the underlying pool after @a seconds.
+         *
+         * Defaults to 30 seconds.
+         */
+        void recycle (uint32 seconds);
+
+        /*!
+         * @internal
+         * @brief Empty the cache of a thread that exits, for reuse.
+         */
+        void vacate (uint32 shelf) throw();
+
+    private:
+        std::atomic<uint32> * shelf ();
+        uint32 take (std::atomic<uint32> * mine);
+        uint32 wrap (ConnectionPool::Lease& lease);
+        void give_back (uint32 index);
+        void release (uint32 index, bool discard);
+        void keep (uint32 index, std::atomic<uint32> * mine);
+    };
+
+    /*!
+     * @brief Connection leased from an affinity pool, returned when
+     *  destroyed.
+     */
+    class AffinityPool::Lease
+    {
+    friend class AffinityPool;
+
+        /* data. */
+    private:
+        AffinityPool * myPool;
+        uint32 myIndex;
+        bool myBroken;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Create an empty lease, to pass to @c try_acquire().
+         */
+        Lease ();
+
+        /*!
+         * @brief Take over @a other's connection.
+         */
+        Lease (Lease&& other);
+
+        /*!
+         * @brief Return the connection to the pool.
+         */
+        ~Lease ();
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Check if the lease holds a connection.
+         */
+        bool valid () const;
+
+        /*!
+         * @brief Access the leased connection.
+         */
+        Connection& connection () const;
+
+        /*!
+         * @brief Close the connection instead of returning it to the pool.
+         */
+        void discard ();
+
+        /*!
+         * @brief Return the connection to the pool now.
+         */
+        void release ();
+
+        /* operators. */
+    public:
+        /*!
+         * @brief Take over @a other's connection, returning the current one.
+         */
+        Lease& operator= (Lease&& other);
+
+        Connection& operator* () const {
+            return (connection());
+        }
+
+        Connection * operator-> () const {
+            return (&connection());
+        }
+    };
+
+}
+
+#endif /* _sql_AffinityPool_hpp__ */
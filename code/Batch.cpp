@@ -0,0 +1,517 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Batch.hpp"
+#include "Diagnostic.hpp"
+#include "Results.hpp"
+
+#include <algorithm>
+
+namespace {
+
+    // Widest character column that is bound to a buffer, in characters.
+    // Wider columns (e.g. long text) make the batch read rows one at a time.
+    const ::SQLULEN max_bound_width = 4096;
+
+    // Native representation used to store values of a given SQL type.
+    ::SQLSMALLINT native_type (::SQLSMALLINT type)
+    {
+        switch (type)
+        {
+        case SQL_BIT:
+        case SQL_TINYINT:        return (SQL_C_STINYINT);
+        case SQL_SMALLINT:       return (SQL_C_SSHORT);
+        case SQL_INTEGER:        return (SQL_C_SLONG);
+        case SQL_BIGINT:         return (SQL_C_SBIGINT);
+        case SQL_REAL:           return (SQL_C_FLOAT);
+        case SQL_FLOAT:
+        case SQL_DOUBLE:         return (SQL_C_DOUBLE);
+        case SQL_NUMERIC:
+        case SQL_DECIMAL:        return (SQL_C_NUMERIC);
+        case SQL_GUID:           return (SQL_C_GUID);
+        case SQL_TYPE_DATE:      return (SQL_C_TYPE_DATE);
+        case SQL_TYPE_TIME:      return (SQL_C_TYPE_TIME);
+        case SQL_TYPE_TIMESTAMP: return (SQL_C_TYPE_TIMESTAMP);
+        }
+        return (SQL_C_CHAR);
+    }
+
+    // Size of a single value, 0 if the column cannot be bound.
+    ::SQLLEN native_width (::SQLSMALLINT type, ::SQLULEN size)
+    {
+        switch (type)
+        {
+        case SQL_C_STINYINT:       return (sizeof(sql::int8));
+        case SQL_C_SSHORT:         return (sizeof(sql::int16));
+        case SQL_C_SLONG:          return (sizeof(sql::int32));
+        case SQL_C_SBIGINT:        return (sizeof(sql::int64));
+        case SQL_C_FLOAT:          return (sizeof(float));
+        case SQL_C_DOUBLE:         return (sizeof(double));
+        case SQL_C_NUMERIC:        return (sizeof(::SQL_NUMERIC_STRUCT));
+        case SQL_C_GUID:           return (sizeof(::SQLGUID));
+        case SQL_C_TYPE_DATE:      return (sizeof(::SQL_DATE_STRUCT));
+        case SQL_C_TYPE_TIME:      return (sizeof(::SQL_TIME_STRUCT));
+        case SQL_C_TYPE_TIMESTAMP: return (sizeof(::SQL_TIMESTAMP_STRUCT));
+        }
+        return (((size > 0) && (size <= ::max_bound_width))? size+1 : 0);
+    }
+
+    ::SQLPOINTER integer_attribute (::SQLLEN value)
+    {
+        return (reinterpret_cast< ::SQLPOINTER >(value));
+    }
+
+    // Numeric values are converted using the application row descriptor's
+    // precision and scale, which ::SQLBindCol() does not set.
+    void describe_numeric (const sql::Handle& statement, ::SQLSMALLINT column,
+                           ::SQLULEN precision, ::SQLSMALLINT scale,
+                           ::SQLPOINTER data)
+    {
+        ::SQLHDESC value = SQL_NULL_HANDLE;
+        ::SQLRETURN result = ::SQLGetStmtAttr(
+            statement.value(), SQL_ATTR_APP_ROW_DESC, &value, 0, 0
+            );
+        if (result != SQL_SUCCESS) {
+            throw (sql::Diagnostic(statement));
+        }
+        const sql::Handle descriptor(value, SQL_HANDLE_DESC,
+                                     &sql::Handle::proxy);
+        result = ::SQLSetDescField(
+            value, column, SQL_DESC_TYPE, integer_attribute(SQL_C_NUMERIC), 0
+            );
+        if (result == SQL_SUCCESS) {
+            result = ::SQLSetDescField(
+                value, column, SQL_DESC_PRECISION,
+                integer_attribute(precision), 0
+                );
+        }
+        if (result == SQL_SUCCESS) {
+            result = ::SQLSetDescField(
+                value, column, SQL_DESC_SCALE, integer_attribute(scale), 0
+                );
+        }
+            // Must be last: setting other fields unbinds the record.
+        if ((result == SQL_SUCCESS) && (data != 0)) {
+            result = ::SQLSetDescField(
+                value, column, SQL_DESC_DATA_PTR, data, 0
+                );
+        }
+        if (result != SQL_SUCCESS) {
+            throw (sql::Diagnostic(descriptor));
+        }
+    }
+
+    void unbind (const sql::Handle& statement) throw()
+    {
+        ::SQLFreeStmt(statement.value(), SQL_UNBIND);
+        ::SQLSetStmtAttr(
+            statement.value(), SQL_ATTR_ROW_ARRAY_SIZE, integer_attribute(1), 0
+            );
+        ::SQLSetStmtAttr(
+            statement.value(), SQL_ATTR_ROWS_FETCHED_PTR, 0, 0
+            );
+    }
+
+    // Append a character value to data, using the length reported by the
+    // driver to size the remaining chunks.
+    ::SQLRETURN get_characters (const sql::Handle& statement,
+                                ::SQLUSMALLINT column,
+                                std::vector<char>& data, ::SQLLEN& indicator)
+    {
+        std::size_t size = data.size();
+        ::SQLLEN chunk = 256;
+        ::SQLRETURN result = SQL_SUCCESS;
+        for (indicator = 0; true;)
+        {
+            data.resize(size+chunk);
+            ::SQLLEN length = 0;
+            result = ::SQLGetData(
+                statement.value(), column, SQL_C_CHAR, &data[size], chunk, &length
+                );
+            if (result == SQL_NO_DATA) {
+                result = SQL_SUCCESS; break;
+            }
+            if ((result != SQL_SUCCESS) && (result != SQL_SUCCESS_WITH_INFO)) {
+                break;
+            }
+            if (length == SQL_NULL_DATA) {
+                indicator = SQL_NULL_DATA; break;
+            }
+            if ((length != SQL_NO_TOTAL) && (length < chunk)) {
+                size += length; result = SQL_SUCCESS; break;
+            }
+                // Truncated: the chunk ends with a null terminator.
+            size += chunk-1;
+            chunk = (length == SQL_NO_TOTAL)? 2*chunk : length-(chunk-1)+1;
+        }
+        data.resize(size);
+        return (result);
+    }
+
+}
+
+namespace sql {
+
+    Batch::Column::Column ()
+        : myName()
+        , myType(SQL_UNKNOWN_TYPE)
+        , mySize(0)
+        , myDigits(0)
+        , myWidth(0)
+        , myNulls(0)
+    {
+    }
+
+    bool Batch::Column::is_int8 () const
+    {
+        return (myType == SQL_C_STINYINT);
+    }
+
+    bool Batch::Column::is_int16 () const
+    {
+        return (myType == SQL_C_SSHORT);
+    }
+
+    bool Batch::Column::is_int32 () const
+    {
+        return (myType == SQL_C_SLONG);
+    }
+
+    bool Batch::Column::is_int64 () const
+    {
+        return (myType == SQL_C_SBIGINT);
+    }
+
+    bool Batch::Column::is_float () const
+    {
+        return (myType == SQL_C_FLOAT);
+    }
+
+    bool Batch::Column::is_double () const
+    {
+        return (myType == SQL_C_DOUBLE);
+    }
+
+    bool Batch::Column::is_numeric () const
+    {
+        return (myType == SQL_C_NUMERIC);
+    }
+
+    bool Batch::Column::is_string () const
+    {
+        return (myType == SQL_C_CHAR);
+    }
+
+    bool Batch::Column::is_guid () const
+    {
+        return (myType == SQL_C_GUID);
+    }
+
+    bool Batch::Column::is_date () const
+    {
+        return (myType == SQL_C_TYPE_DATE);
+    }
+
+    bool Batch::Column::is_time () const
+    {
+        return (myType == SQL_C_TYPE_TIME);
+    }
+
+    bool Batch::Column::is_timestamp () const
+    {
+        return (myType == SQL_C_TYPE_TIMESTAMP);
+    }
+
+    void Batch::Column::swap (std::vector<char>& data,
+                              std::vector<int32>& offsets,
+                              std::vector<uint8>& validity)
+    {
+        myData.swap(data);
+        myOffsets.swap(offsets);
+        myValidity.swap(validity);
+    }
+
+    Batch::Batch (size_t capacity)
+        : myColumns()
+        , myCapacity((capacity > 1)? capacity : 1)
+        , myRows(0)
+        , myResultSet(0)
+        , myBlocks(false)
+    {
+    }
+
+    bool Batch::fetch (Results& results)
+    {
+        myRows = 0;
+        if (!results) {
+            return (false);
+        }
+
+            // Take over the cursor from row-by-row reads.  Handles are
+            // reused, so compare result sets, not statements.
+        const uint64 result_set = results.statement().result_set();
+        if (myColumns.empty() || (myResultSet != result_set))
+        {
+            results.release();
+            describe(results);
+            myResultSet = result_set;
+        }
+
+        if (myBlocks)
+        {
+            bind(results);
+            const ::SQLRETURN result = ::SQLFetch(results.handle().value());
+            if ((result != SQL_SUCCESS) &&
+                (result != SQL_SUCCESS_WITH_INFO) && (result != SQL_NO_DATA))
+            {
+                const Diagnostic diagnostic(results.handle());
+                ::unbind(results.handle());
+                throw (diagnostic);
+            }
+            if (result == SQL_NO_DATA) {
+                myRows = 0;
+            }
+            if (!pack(results.handle()))
+            {
+                const Diagnostic diagnostic(results.handle());
+                ::unbind(results.handle());
+                throw (diagnostic);
+            }
+            ::unbind(results.handle());
+        }
+        else {
+            read(results);
+        }
+
+        finish();
+        if (myRows == 0) {
+            results.myState.set(Results::State::fail());
+        }
+        return (myRows > 0);
+    }
+
+    void Batch::describe (Results& results)
+    {
+        const std::vector<ColumnInfo>& columns =
+            results.statement().columns();
+        myColumns.assign(columns.size(), Column());
+        myBlocks = true;
+        for (std::size_t i = 0; (i < columns.size()); ++i)
+        {
+            Column& column = myColumns[i];
+            column.myName = columns[i].name();
+            column.mySize = columns[i].size();
+            column.myDigits = columns[i].digits();
+            column.myType = ::native_type(columns[i].type());
+            column.myWidth = ::native_width(column.myType, column.mySize);
+            if (column.myWidth == 0) {
+                myBlocks = false;
+            }
+        }
+    }
+
+    void Batch::bind (Results& results)
+    {
+        const Handle& statement = results.handle();
+        for (std::size_t i = 0; (i < myColumns.size()); ++i)
+        {
+            Column& column = myColumns[i];
+            const ::SQLUSMALLINT index = static_cast< ::SQLUSMALLINT >(i+1);
+
+                // Fixed-size values are fetched straight into the batch;
+                // strings are fetched in fixed-size slots, then packed.
+            std::vector<char>& buffer =
+                column.is_string()? column.myBuffer : column.myData;
+            buffer.resize(myCapacity*column.myWidth);
+            column.myLengths.resize(myCapacity);
+            const ::SQLRETURN result = ::SQLBindCol(
+                statement.value(), index, column.myType, &buffer[0],
+                column.myWidth, &column.myLengths[0]
+                );
+            if (result != SQL_SUCCESS) {
+                const Diagnostic diagnostic(statement);
+                ::unbind(statement);
+                throw (diagnostic);
+            }
+            if (column.is_numeric()) {
+                ::describe_numeric(statement, index, column.mySize,
+                                   column.myDigits, &buffer[0]);
+            }
+        }
+
+        ::SQLRETURN result = ::SQLSetStmtAttr(
+            statement.value(), SQL_ATTR_ROW_ARRAY_SIZE,
+            ::integer_attribute(myCapacity), 0
+            );
+        if (result == SQL_SUCCESS) {
+            result = ::SQLSetStmtAttr(
+                statement.value(), SQL_ATTR_ROWS_FETCHED_PTR, &myRows, 0
+                );
+        }
+        if (result != SQL_SUCCESS) {
+            const Diagnostic diagnostic(statement);
+            ::unbind(statement);
+            throw (diagnostic);
+        }
+    }
+
+    void Batch::read (Results& results)
+    {
+        const Handle& statement = results.handle();
+        for (std::size_t i = 0; (i < myColumns.size()); ++i)
+        {
+            Column& column = myColumns[i];
+            column.myLengths.resize(myCapacity);
+            if (column.is_string()) {
+                column.myData.clear();
+                column.myOffsets.assign(1, 0);
+            }
+            else {
+                column.myData.resize(myCapacity*column.myWidth);
+            }
+            if (column.is_numeric()) {
+                ::describe_numeric(statement, static_cast< ::SQLSMALLINT >(i+1),
+                                   column.mySize, column.myDigits, 0);
+            }
+        }
+
+        for (; (myRows < myCapacity); ++myRows)
+        {
+            ::SQLRETURN result = ::SQLFetch(statement.value());
+            if (result == SQL_NO_DATA) {
+                break;
+            }
+            for (std::size_t i = 0;
+                 (i < myColumns.size()) &&
+                 ((result == SQL_SUCCESS) || (result == SQL_SUCCESS_WITH_INFO));
+                 ++i)
+            {
+                Column& column = myColumns[i];
+                const ::SQLUSMALLINT index = static_cast< ::SQLUSMALLINT >(i+1);
+                ::SQLLEN& length = column.myLengths[myRows];
+                if (column.is_string())
+                {
+                    result = ::get_characters(
+                        statement, index, column.myData, length
+                        );
+                    column.myOffsets.push_back(
+                        static_cast<int32>(column.myData.size())
+                        );
+                }
+                else
+                {
+                    result = ::SQLGetData(
+                        statement.value(), index,
+                        column.is_numeric()? SQL_ARD_TYPE : column.myType,
+                        &column.myData[myRows*column.myWidth],
+                        column.myWidth, &length
+                        );
+                }
+            }
+            if ((result != SQL_SUCCESS) && (result != SQL_SUCCESS_WITH_INFO))
+            {
+                const Diagnostic diagnostic(statement);
+                ::SQLFreeStmt(statement.value(), SQL_UNBIND);
+                throw (diagnostic);
+            }
+        }
+
+            // Drop numeric descriptor records.
+        ::SQLFreeStmt(statement.value(), SQL_UNBIND);
+    }
+
+    bool Batch::pack (const Handle& statement)
+    {
+        for (std::size_t i = 0; (i < myColumns.size()); ++i)
+        {
+            Column& column = myColumns[i];
+            if (!column.is_string()) {
+                continue;
+            }
+            column.myData.clear();
+            column.myOffsets.assign(1, 0);
+            for (::SQLULEN row = 0; (row < myRows); ++row)
+            {
+                ::SQLLEN& length = column.myLengths[row];
+                if ((length == SQL_NO_TOTAL) || (length >= column.myWidth))
+                {
+                        // Truncated: read the whole value from the row.
+                    ::SQLRETURN result = ::SQLSetPos(
+                        statement.value(),
+                        static_cast< ::SQLSETPOSIROW >(row+1),
+                        SQL_POSITION, SQL_LOCK_NO_CHANGE
+                        );
+                    if (result == SQL_SUCCESS) {
+                        result = ::get_characters(
+                            statement, static_cast< ::SQLUSMALLINT >(i+1),
+                            column.myData, length
+                            );
+                    }
+                    if (result != SQL_SUCCESS) {
+                        return (false);
+                    }
+                }
+                else if (length != SQL_NULL_DATA)
+                {
+                    const char *const first =
+                        &column.myBuffer[row*column.myWidth];
+                    column.myData.insert(
+                        column.myData.end(), first, first+length
+                        );
+                }
+                column.myOffsets.push_back(
+                    static_cast<int32>(column.myData.size())
+                    );
+            }
+        }
+        return (true);
+    }
+
+    void Batch::finish ()
+    {
+        for (std::size_t i = 0; (i < myColumns.size()); ++i)
+        {
+            Column& column = myColumns[i];
+            column.myValidity.assign((myRows+7)/8, 0);
+            column.myNulls = 0;
+            for (::SQLULEN row = 0; (row < myRows); ++row)
+            {
+                if (column.myLengths[row] == SQL_NULL_DATA) {
+                    ++column.myNulls;
+                }
+                else {
+                    column.myValidity[row/8] |= (1 << (row%8));
+                }
+            }
+        }
+    }
+
+    Results& operator>> (Results& results, Batch& batch)
+    {
+        batch.fetch(results); return (results);
+    }
+
+}
@@ -0,0 +1,380 @@
+#ifndef _sql_Batch_hpp__
+#define _sql_Batch_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+#include "types.hpp"
+#include "NotCopyable.hpp"
+#include "string.hpp"
+#include <vector>
+
+namespace sql {
+
+    class Handle;
+    class Results;
+
+    /*!
+     * @brief Block of rows stored column by column.
+     *
+     * Each column is stored as a single contiguous array of values, along
+     * with a validity bitmap.  Strings are stored as a single character
+     * buffer and an array of offsets.  This layout is the same as the one
+     * used by Apache Arrow and allows tight loops over plain arrays.
+     *
+     * Batches are filled from a result set, @c capacity() rows at a time:
+     * @code
+     *  sql::Results results(statement);
+     *  sql::Batch batch(4096);
+     *  while (results >> batch) {
+     *    const sql::Batch::Column& column = batch.column(0);
+     *    const sql::int32 * values = column.values<sql::int32>();
+     *    for (sql::size_t i = 0; (i < batch.rows()); ++i) {
+     *      if (!column.null(i)) {
+     *        // ... values[i] ...
+     *      }
+     *    }
+     *  }
+     * @endcode
+     *
+     * Column types are selected from the columns' SQL types: integers,
+     * floating point values, dates, times, timestamps, unique identifiers
+     * and numeric values use their native representation and all other
+     * types are converted to strings.
+     *
+     * @note Once a batch has been read from a result set, rows can no longer
+     *  be read one at a time from that result set.
+     */
+    class Batch :
+        private NotCopyable
+    {
+        /* nested types. */
+    public:
+        /*!
+         * @brief Values for a single column of the batch.
+         */
+        class Column
+        {
+        friend class Batch;
+
+            /* data. */
+        private:
+            string myName;
+            ::SQLSMALLINT myType;
+            ::SQLULEN mySize;
+            ::SQLSMALLINT myDigits;
+            ::SQLLEN myWidth;
+            std::vector<char> myData;
+            std::vector<int32> myOffsets;
+            std::vector<uint8> myValidity;
+            std::vector< ::SQLLEN > myLengths;
+            std::vector<char> myBuffer;
+            size_t myNulls;
+
+            /* construction. */
+        public:
+            /*!
+             * @internal
+             * @brief Build an empty column, of unknown type.
+             */
+            Column ();
+
+            /* methods. */
+        public:
+            /*!
+             * @brief Obtain the column name, as reported by the driver.
+             */
+            const string& name () const {
+                return (myName);
+            }
+
+            /*!
+             * @brief Obtain the native C type code used to store values.
+             *
+             * @see is_int8()
+             * @see is_int16()
+             * @see is_int32()
+             * @see is_int64()
+             * @see is_float()
+             * @see is_double()
+             * @see is_numeric()
+             * @see is_string()
+             * @see is_guid()
+             * @see is_date()
+             * @see is_time()
+             * @see is_timestamp()
+             */
+            int16 type () const {
+                return (myType);
+            }
+
+            /*!
+             * @brief Obtain the precision of numeric values.
+             */
+            size_t precision () const {
+                return (mySize);
+            }
+
+            /*!
+             * @brief Obtain the scale of numeric values.
+             */
+            int16 scale () const {
+                return (myDigits);
+            }
+
+            /*!
+             * @brief Check if values are stored as @c int8.
+             */
+            bool is_int8 () const;
+
+            /*!
+             * @brief Check if values are stored as @c int16.
+             */
+            bool is_int16 () const;
+
+            /*!
+             * @brief Check if values are stored as @c int32.
+             */
+            bool is_int32 () const;
+
+            /*!
+             * @brief Check if values are stored as @c int64.
+             */
+            bool is_int64 () const;
+
+            /*!
+             * @brief Check if values are stored as @c float.
+             */
+            bool is_float () const;
+
+            /*!
+             * @brief Check if values are stored as @c double.
+             */
+            bool is_double () const;
+
+            /*!
+             * @brief Check if values are stored as @c Numeric::Value.
+             */
+            bool is_numeric () const;
+
+            /*!
+             * @brief Check if values are stored as strings.
+             *
+             * @see characters()
+             * @see offsets()
+             */
+            bool is_string () const;
+
+            /*!
+             * @brief Check if values are stored as @c Guid::Value.
+             */
+            bool is_guid () const;
+
+            /*!
+             * @brief Check if values are stored as @c Date::Value.
+             */
+            bool is_date () const;
+
+            /*!
+             * @brief Check if values are stored as @c Time::Value.
+             */
+            bool is_time () const;
+
+            /*!
+             * @brief Check if values are stored as @c Timestamp::Value.
+             */
+            bool is_timestamp () const;
+
+            /*!
+             * @brief Access the array of fixed-size values.
+             * @return A pointer to the first of @c Batch::rows() values.
+             * @pre @a T matches @c type().
+             *
+             * The value of null entries is unspecified.
+             */
+            template<typename T>
+            const T * values () const {
+                return (reinterpret_cast<const T*>(data()));
+            }
+
+            /*!
+             * @brief Access the characters of all string values.
+             * @pre @c is_string().
+             *
+             * The value for row @c i is the range [@c characters()+offsets()[i],
+             * @c characters()+offsets()[i+1]).  Values are not null
+             * terminated.
+             */
+            const character * characters () const {
+                return (reinterpret_cast<const character*>(data()));
+            }
+
+            /*!
+             * @brief Access the offsets of string values.
+             * @return A pointer to the first of @c Batch::rows()+1 offsets.
+             * @pre @c is_string().
+             */
+            const int32 * offsets () const {
+                return (myOffsets.empty()? 0 : &myOffsets[0]);
+            }
+
+            /*!
+             * @brief Access the validity bitmap.
+             *
+             * Bit @c i (least significant bit first) is set if the value at
+             * row @c i is not null.
+             */
+            const uint8 * validity () const {
+                return (myValidity.empty()? 0 : &myValidity[0]);
+            }
+
+            /*!
+             * @brief Check if the value at @a row is null.
+             */
+            bool null (size_t row) const {
+                return ((myValidity[row/8] & (1 << (row%8))) == 0);
+            }
+
+            /*!
+             * @brief Obtain the number of null values in the column.
+             */
+            size_t null_count () const {
+                return (myNulls);
+            }
+
+            /*!
+             * @internal
+             * @brief Hand over the column's buffers without copying them.
+             * @param data Receives the values (characters, for strings).
+             * @param offsets Receives the string offsets.
+             * @param validity Receives the validity bitmap.
+             *
+             * The column is left empty until the next @c Batch::fetch().
+             */
+            void swap (std::vector<char>& data, std::vector<int32>& offsets,
+                       std::vector<uint8>& validity);
+
+        private:
+            const char * data () const {
+                return (myData.empty()? 0 : &myData[0]);
+            }
+        };
+
+        /* data. */
+    private:
+        std::vector<Column> myColumns;
+        ::SQLULEN myCapacity;
+        ::SQLULEN myRows;
+        uint64 myResultSet;
+        bool myBlocks;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Prepare an empty batch.
+         * @param capacity Maximum number of rows read at once.  This bounds
+         *  the memory used by each column.
+         */
+        explicit Batch (size_t capacity = 1024);
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Obtain the maximum number of rows read at once.
+         */
+        size_t capacity () const {
+            return (myCapacity);
+        }
+
+        /*!
+         * @brief Obtain the number of rows in the batch.
+         */
+        size_t rows () const {
+            return (myRows);
+        }
+
+        /*!
+         * @brief Obtain the number of columns in the batch.
+         */
+        size_t columns () const {
+            return (myColumns.size());
+        }
+
+        /*!
+         * @brief Access the values of a column.
+         * @param index Column index, starting at 0.
+         */
+        const Column& column (size_t index) const {
+            return (myColumns[index]);
+        }
+
+        /*!
+         * @brief Access the values of a column.
+         * @param index Column index, starting at 0.
+         */
+        Column& column (size_t index) {
+            return (myColumns[index]);
+        }
+
+        /*!
+         * @brief Replace contents with the next rows in @a results.
+         * @param results Result set from which to read rows.
+         * @return @c true if at least one row was read.
+         *
+         * Columns that can be bound to fixed-size buffers are fetched
+         * @c capacity() rows per driver call, straight into the batch's
+         * arrays.  When the result set contains long data, rows are read
+         * one at a time instead.
+         *
+         * String values that do not fit in their column's declared size
+         * (some drivers treat it as a hint) are read again in full using
+         * ::SQLGetData().
+         */
+        bool fetch (Results& results);
+
+    private:
+        void describe (Results& results);
+        void bind (Results& results);
+        void read (Results& results);
+        bool pack (const Handle& statement);
+        void finish ();
+    };
+
+    /*!
+     * @brief Read the next block of rows from @a results.
+     * @param results Result set from which to read rows.
+     * @param batch Batch in which to store the rows.
+     * @return @a results, for method chaining.  Its state is set to
+     *  @c Results::State::fail() when no rows are left.
+     *
+     * @see Batch::fetch()
+     */
+    Results& operator>> (Results& results, Batch& batch);
+
+}
+
+#endif /* _sql_Batch_hpp__ */
@@ -0,0 +1,146 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "BulkLoader.hpp"
+#include "Connection.hpp"
+
+namespace sql {
+
+    BulkLoader::BulkLoader (Connection& connection, const string& text,
+                            size_t batch_rows, size_t batch_bytes,
+                            size_t commit_batches)
+        : myConnection(connection)
+        , myStatement(connection, text)
+        , myColumns(myStatement.parameter_count(), 0)
+        , myColumn(0)
+        , myBatchRows((batch_rows > 0)? batch_rows : 1)
+        , myBatchBytes(batch_bytes)
+        , myCommitBatches((commit_batches > 0)? commit_batches : 1)
+        , myRows(0)
+        , myBytes(0)
+        , myBatches(0)
+        , myLoaded(0)
+        , myAutocommit(connection.autocommit())
+        , myFinished(false)
+    {
+        if (myAutocommit) {
+            myConnection.disable_autocommit();
+        }
+    }
+
+    BulkLoader::~BulkLoader ()
+    {
+        for (std::size_t i = 0; (i < myColumns.size()); ++i) {
+            delete myColumns[i];
+        }
+            // Best effort: this runs during unwinding, when a load failed.
+        if (myAutocommit && !myFinished)
+        {
+            try {
+                myConnection.rollback();
+            }
+            catch ( ... ) {
+            }
+            try {
+                myConnection.enable_autocommit();
+            }
+            catch ( ... ) {
+            }
+        }
+    }
+
+    BulkLoader& BulkLoader::end_row ()
+    {
+        if (myColumn != myColumns.size()) {
+            throw (std::invalid_argument(
+                "sql::BulkLoader: too few values in row."
+                ));
+        }
+        myColumn = 0;
+        ++myRows;
+        if ((myRows >= myBatchRows) ||
+            ((myBatchBytes > 0) && (myBytes >= myBatchBytes)))
+        {
+            flush();
+            if (myAutocommit && (myBatches >= myCommitBatches)) {
+                commit();
+            }
+        }
+        return (*this);
+    }
+
+    void BulkLoader::flush ()
+    {
+        if (myColumn != 0) {
+            throw (std::invalid_argument(
+                "sql::BulkLoader: cannot flush in the middle of a row."
+                ));
+        }
+        if (myRows == 0) {
+            return;
+        }
+        myStatement.reset();
+        for (std::size_t i = 0; (i < myColumns.size()); ++i) {
+            myColumns[i]->bind(myStatement);
+        }
+        myStatement.execute();
+        for (std::size_t i = 0; (i < myColumns.size()); ++i) {
+            myColumns[i]->clear();
+        }
+        myLoaded += myRows;
+        myRows = 0;
+        myBytes = 0;
+        ++myBatches;
+    }
+
+    void BulkLoader::commit ()
+    {
+        flush();
+        myConnection.commit();
+        myBatches = 0;
+    }
+
+    void BulkLoader::finish ()
+    {
+        if (myFinished) {
+            return;
+        }
+        if (myAutocommit) {
+            commit();
+            myConnection.enable_autocommit();
+        }
+        else {
+            flush();
+        }
+        myFinished = true;
+    }
+
+    BulkLoader& operator<< (BulkLoader& loader, const Row&)
+    {
+        return (loader.end_row());
+    }
+
+}
@@ -0,0 +1,229 @@
+#ifndef _sql_BulkLoader_hpp__
+#define _sql_BulkLoader_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+#include "types.hpp"
+#include "string.hpp"
+#include "NotCopyable.hpp"
+#include "PreparedStatement.hpp"
+#include "Results.hpp"
+#include <stdexcept>
+#include <vector>
+
+namespace sql {
+
+    class Connection;
+
+    /*!
+     * @ingroup transactions
+     * @brief Batched, chunked loading of many rows with a single statement.
+     *
+     * Rows are appended one value at a time and buffered in parameter
+     * arrays.  The buffered rows are executed in a single driver call when
+     * either the row or the byte threshold is reached, and the transaction
+     * is committed after every few batches so that it stays bounded:
+     * @code
+     *  sql::BulkLoader loader(connection,
+     *      "insert into entries (id, name) values (?, ?);");
+     *  for (...) {
+     *    loader << id << name << sql::row;
+     *  }
+     *  loader.finish();
+     * @endcode
+     *
+     * When auto-commit is enabled, the loader disables it for its lifetime
+     * and manages the transaction itself.  If it is destroyed without
+     * calling @c finish(), rows that were not yet committed are rolled
+     * back; earlier chunks remain committed.  When auto-commit is already
+     * disabled, the transaction belongs to the caller: batches are only
+     * executed, never committed nor rolled back by the loader.
+     *
+     * @see PreparedStatement::bind(const std::vector<int32>&)
+     */
+    class BulkLoader :
+        private NotCopyable
+    {
+        /* nested types. */
+    private:
+        class Column
+        {
+        public:
+            virtual ~Column () {}
+            virtual void bind (PreparedStatement& statement) const = 0;
+            virtual void clear () = 0;
+        };
+
+        template<typename T>
+        class Values :
+            public Column
+        {
+        public:
+            std::vector<T> values;
+
+            virtual void bind (PreparedStatement& statement) const {
+                statement.bind(values);
+            }
+
+            virtual void clear () {
+                values.clear();
+            }
+        };
+
+        /* data. */
+    private:
+        Connection& myConnection;
+        PreparedStatement myStatement;
+        std::vector<Column*> myColumns;
+        std::size_t myColumn;
+        size_t myBatchRows;
+        size_t myBatchBytes;
+        size_t myCommitBatches;
+        size_t myRows;
+        size_t myBytes;
+        size_t myBatches;
+        size_t myLoaded;
+        bool myAutocommit;
+        bool myFinished;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Prepare @a text for loading rows.
+         * @param connection Connection over which to load the rows.
+         * @param text SQL statement with one placeholder per column.
+         * @param batch_rows Execute buffered rows once this many are ready.
+         * @param batch_bytes Execute buffered rows once their values use
+         *  this many bytes.
+         * @param commit_batches Commit after this many batches, if the
+         *  loader manages the transaction.
+         */
+        BulkLoader (Connection& connection, const string& text,
+                    size_t batch_rows=1000, size_t batch_bytes=1024*1024,
+                    size_t commit_batches=10);
+
+        /*!
+         * @brief Roll back uncommitted rows, unless @c finish() was called
+         *  or the caller owns the transaction.
+         */
+        ~BulkLoader ();
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Append a value to the current row.
+         *
+         * All values in a column must have the same type.
+         */
+        template<typename T>
+        BulkLoader& append (const T& value)
+        {
+            if (myColumn >= myColumns.size()) {
+                throw (std::invalid_argument(
+                    "sql::BulkLoader: too many values in row."
+                    ));
+            }
+            Column *& column = myColumns[myColumn];
+            if (column == 0) {
+                column = new Values<T>();
+            }
+            Values<T> *const values = dynamic_cast<Values<T>*>(column);
+            if (values == 0) {
+                throw (std::invalid_argument(
+                    "sql::BulkLoader: value type changed within a column."
+                    ));
+            }
+            values->values.push_back(value);
+            myBytes += size_of(value);
+            ++myColumn; return (*this);
+        }
+
+        /*!
+         * @brief End the current row, executing a batch if it is full.
+         */
+        BulkLoader& end_row ();
+
+        /*!
+         * @brief Execute all buffered rows.
+         */
+        void flush ();
+
+        /*!
+         * @brief Execute all buffered rows and commit.
+         */
+        void commit ();
+
+        /*!
+         * @brief Execute all buffered rows and, if the loader manages the
+         *  transaction, commit them and restore auto-commit.
+         */
+        void finish ();
+
+        /*!
+         * @brief Number of rows buffered and not yet executed.
+         */
+        size_t pending () const {
+            return (myRows);
+        }
+
+        /*!
+         * @brief Number of rows executed so far.
+         */
+        size_t loaded () const {
+            return (myLoaded);
+        }
+
+    private:
+        template<typename T>
+        static size_t size_of (const T&) {
+            return (sizeof(T));
+        }
+
+        template<typename Char>
+        static size_t size_of (const basic_string<Char>& value) {
+            return (value.length()*sizeof(Char));
+        }
+    };
+
+    /*!
+     * @brief Appends any supported value to the current row.
+     */
+    template<typename Value>
+    BulkLoader& operator<< (BulkLoader& loader, const Value& value)
+    {
+        return (loader.append(value));
+    }
+
+    /*!
+     * @brief Ends the current row.
+     */
+    BulkLoader& operator<< (BulkLoader& loader, const Row&);
+
+}
+
+#endif /* _sql_BulkLoader_hpp__ */
@@ -0,0 +1,129 @@
+#ifndef _sql_Bytes_hpp__
+#define _sql_Bytes_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+#include "types.hpp"
+
+namespace sql {
+
+    /*!
+     * @brief Binary value stored in caller-provided memory.
+     *
+     * This does not own nor copy the memory it refers to.  When bound to a
+     * parameter, the bytes are sent straight from the caller's buffer and
+     * when read from a column, the value is written straight into it.  The
+     * memory must remain valid until the statement is executed or the column
+     * is read, respectively.
+     *
+     * @code
+     *  std::vector<char> buffer(1024);
+     *  sql::Bytes bytes(&buffer[0], buffer.size());
+     *  while (results >> sql::row >> bytes) {
+     *    // bytes.size() bytes of buffer are set.
+     *  }
+     * @endcode
+     */
+    class Bytes
+    {
+        /* data. */
+    private:
+        void * myData;
+        size_t myCapacity;
+        mutable ::SQLLEN myLength;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Refer to a buffer holding @a size bytes.
+         * @param data Start of the buffer.
+         * @param size Size of the value, which is also the capacity of the
+         *  buffer when reading a column into it.
+         */
+        Bytes (const void * data, size_t size)
+            : myData(const_cast<void*>(data))
+            , myCapacity(size)
+            , myLength(size)
+        {}
+
+        /*!
+         * @brief Refer to a buffer that is larger than its value.
+         * @param data Start of the buffer.
+         * @param capacity Size of the buffer, in bytes.
+         * @param size Size of the value currently in the buffer.
+         */
+        Bytes (void * data, size_t capacity, size_t size)
+            : myData(data)
+            , myCapacity(capacity)
+            , myLength(size)
+        {}
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Access the caller's buffer.
+         */
+        void * data () const {
+            return (myData);
+        }
+
+        /*!
+         * @brief Size of the caller's buffer, in bytes.
+         */
+        size_t capacity () const {
+            return (myCapacity);
+        }
+
+        /*!
+         * @brief Size of the value, in bytes.
+         * @return 0 if the value is null.
+         */
+        size_t size () const {
+            return ((myLength == SQL_NULL_DATA)? 0 : myLength);
+        }
+
+        /*!
+         * @brief Check if the value read from a column was null.
+         */
+        bool null () const {
+            return (myLength == SQL_NULL_DATA);
+        }
+
+        /*!
+         * @internal
+         * @brief Length/indicator used by ::SQLBindParameter() and
+         *  ::SQLGetData().
+         */
+        ::SQLLEN * indicator () const {
+            return (&myLength);
+        }
+    };
+
+}
+
+#endif /* _sql_Bytes_hpp__ */
@@ -0,0 +1,107 @@
+#ifndef _sql_ColumnInfo_hpp__
+#define _sql_ColumnInfo_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+#include "types.hpp"
+#include "string.hpp"
+
+namespace sql {
+
+    /*!
+     * @brief Description of a result set column.
+     *
+     * @see Statement::columns()
+     */
+    class ColumnInfo
+    {
+        /* data. */
+    private:
+        string myName;
+        ::SQLSMALLINT myType;
+        ::SQLULEN mySize;
+        ::SQLSMALLINT myDigits;
+        ::SQLSMALLINT myNull;
+
+        /* construction. */
+    public:
+        /*!
+         * @internal
+         * @brief Build from the values reported by ::SQLDescribeCol().
+         */
+        ColumnInfo (const string& name, ::SQLSMALLINT type, ::SQLULEN size,
+                    ::SQLSMALLINT digits, ::SQLSMALLINT nullable)
+            : myName(name), myType(type), mySize(size)
+            , myDigits(digits), myNull(nullable)
+        {}
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Column name (or alias), empty if the driver has none.
+         */
+        const string& name () const {
+            return (myName);
+        }
+
+        /*!
+         * @brief SQL data type code (e.g. @c SQL_INTEGER).
+         */
+        int16 type () const {
+            return (myType);
+        }
+
+        /*!
+         * @brief Column size: characters for text, precision for numbers.
+         * @return 0 if the size cannot be determined.
+         */
+        size_t size () const {
+            return (mySize);
+        }
+
+        /*!
+         * @brief Decimal digits: scale for numeric values, fractional
+         *  seconds precision for time values.
+         */
+        int16 digits () const {
+            return (myDigits);
+        }
+
+        /*!
+         * @brief Check if the column is nullable.
+         * @return @c false if the column is not nullable or if the driver
+         *  cannot determine nullability.
+         */
+        bool nullable () const {
+            return (myNull == SQL_NULLABLE);
+        }
+    };
+
+}
+
+#endif /* _sql_ColumnInfo_hpp__ */
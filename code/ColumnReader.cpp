@@ -0,0 +1,107 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "ColumnReader.hpp"
+#include "Results.hpp"
+
+namespace sql {
+
+    ColumnReader::ColumnReader (Results& results, size_t size, bool binary)
+        : myResults(results)
+        , myColumn(0)
+        , myType(binary? SQL_C_BINARY : SQL_C_CHAR)
+        , myBuffer((size > 1)? size : 2)
+        , myDone(true)
+        , myNull(false)
+    {
+        if (!myResults) {
+            return;
+        }
+
+            // Values in a block cannot be read using ::SQLGetData().
+        if (myResults.myBinding > 1) {
+            myResults.myState.set(Results::State::fail());
+            return;
+        }
+        if (myResults.myColumn <= myResults.myBound) {
+            myResults.release();
+        }
+        myColumn = myResults.myColumn++;
+        myDone = false;
+    }
+
+    size_t ColumnReader::next (const char *& data)
+    {
+        if (myDone) {
+            return (0);
+        }
+
+        const ::SQLLEN size = myBuffer.size();
+        ::SQLLEN length = 0;
+        const ::SQLRETURN result = ::SQLGetData(
+            myResults.handle().value(), myColumn, myType,
+            &myBuffer[0], size, &length
+            );
+        if (result == SQL_NO_DATA) {
+            myDone = true; return (0);
+        }
+        if ((result != SQL_SUCCESS) && (result != SQL_SUCCESS_WITH_INFO)) {
+            myResults.myState.set(Results::State::fail());
+            myDone = true; return (0);
+        }
+        if (length == SQL_NULL_DATA) {
+            myNull = myDone = true; return (0);
+        }
+
+            // Character data is null terminated in each chunk.
+        const ::SQLLEN room = (myType == SQL_C_CHAR)? size-1 : size;
+        ::SQLLEN used = room;
+        if ((length != SQL_NO_TOTAL) && (length <= room)) {
+            used = length, myDone = true;
+        }
+        else if (result == SQL_SUCCESS) {
+            myDone = true;
+        }
+        data = &myBuffer[0];
+        return (used);
+    }
+
+    ColumnReader::int_type ColumnReader::underflow ()
+    {
+        if (gptr() < egptr()) {
+            return (traits_type::to_int_type(*gptr()));
+        }
+        const char * data = 0;
+        const size_t used = next(data);
+        if (used == 0) {
+            return (traits_type::eof());
+        }
+        char *const first = &myBuffer[0];
+        setg(first, first, first+used);
+        return (traits_type::to_int_type(*gptr()));
+    }
+
+}
@@ -0,0 +1,135 @@
+#ifndef _sql_ColumnReader_hpp__
+#define _sql_ColumnReader_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+#include "types.hpp"
+#include "NotCopyable.hpp"
+#include <streambuf>
+#include <vector>
+
+namespace sql {
+
+    class Results;
+
+    /*!
+     * @brief Incremental reader for a single (large) column.
+     *
+     * Reads the next column of the current row in fixed-size chunks, using
+     * a single reusable buffer, so that text and binary values of any size
+     * can be consumed with constant memory.  This is a standard stream
+     * buffer, so it can be wrapped in a @c std::istream:
+     * @code
+     *  while (results >> sql::row) {
+     *    sql::ColumnReader reader(results);
+     *    std::istream stream(&reader);
+     *    // ... read from stream ...
+     *  }
+     * @endcode
+     *
+     * Constructing the reader consumes the column, like the @c Results
+     * extraction operators.  The reader must be drained before reading the
+     * next column or row.
+     *
+     * @see stream()
+     */
+    class ColumnReader :
+        public std::streambuf,
+        private NotCopyable
+    {
+        /* data. */
+    private:
+        Results& myResults;
+        ::SQLUSMALLINT myColumn;
+        ::SQLSMALLINT myType;
+        std::vector<char> myBuffer;
+        bool myDone;
+        bool myNull;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Start reading the next column of @a results.
+         * @param results Result set positioned on a row.
+         * @param size Size of the chunk buffer, in bytes.
+         * @param binary Read raw bytes rather than (null terminated)
+         *  character data.
+         */
+        explicit ColumnReader (Results& results, size_t size = 65536,
+                               bool binary = false);
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Check if the column is null.
+         *
+         * This is only known once the first chunk has been read.
+         */
+        bool null () const {
+            return (myNull);
+        }
+
+        /*!
+         * @brief Read the next chunk.
+         * @param data Receives a pointer to the chunk.  It remains valid
+         *  until the next call.
+         * @return The size of the chunk, in bytes, 0 when the value is
+         *  exhausted.
+         */
+        size_t next (const char *& data);
+
+        /* overrides. */
+    protected:
+        virtual int_type underflow ();
+    };
+
+    /*!
+     * @brief Pass the next column to @a sink, one chunk at a time.
+     * @param results Result set positioned on a row.
+     * @param sink Function called as @c sink(data,size) for each chunk.
+     * @param size Size of the chunk buffer, in bytes.
+     * @param binary Read raw bytes rather than character data.
+     * @return @a results, for method chaining.
+     */
+    template<typename Sink>
+    Results& stream (Results& results, Sink sink,
+                     size_t size = 65536, bool binary = false)
+    {
+        ColumnReader reader(results, size, binary);
+        const char * data = 0;
+        for (size_t used = reader.next(data);
+             (used > 0); used = reader.next(data))
+        {
+            sink(data, used);
+        }
+        return (results);
+    }
+
+}
+
+#endif /* _sql_ColumnReader_hpp__ */
@@ -132,11 +132,13 @@ namespace sql {
 
     Connection::Connection (Environment& environment)
         : myHandle(::allocate(environment), SQL_HANDLE_DBC, &Handle::claim)
+        , myMutex(), myIdle(), myIdleLimit(16), myIdleTimeout(60)
     {
     }
 
     Connection::~Connection ()
     {
+        release_statements();
     }
 
     const Handle& Connection::handle () const throw()
@@ -170,6 +172,18 @@ namespace sql {
         }
     }
 
+    bool Connection::autocommit () const
+    {
+        ::SQLUINTEGER value = SQL_AUTOCOMMIT_ON;
+        const ::SQLRETURN result = ::SQLGetConnectAttr(
+            handle().value(), SQL_ATTR_AUTOCOMMIT, &value, SQL_IS_UINTEGER, 0
+            );
+        if (result != SQL_SUCCESS) {
+            throw (Diagnostic(handle()));
+        }
+        return (value == SQL_AUTOCOMMIT_ON);
+    }
+
     void Connection::commit ()
     {
         ::SQLRETURN result = ::SQLEndTran(
@@ -255,4 +269,90 @@ namespace sql {
                                      SQL_MAX_TABLE_NAME_LEN));
     }
 
+    void Connection::pool_statements (std::size_t count, uint32 timeout)
+    {
+        const std::lock_guard<std::mutex> lock(myMutex);
+        myIdleLimit = count;
+        myIdleTimeout = std::chrono::seconds(timeout);
+        while (myIdle.size() > myIdleLimit) {
+            ::SQLFreeHandle(SQL_HANDLE_STMT, myIdle.front().handle);
+            myIdle.pop_front();
+        }
+    }
+
+    std::size_t Connection::idle_statements ()
+    {
+        const std::lock_guard<std::mutex> lock(myMutex);
+        return (myIdle.size());
+    }
+
+    void Connection::release_statements ()
+    {
+        const std::lock_guard<std::mutex> lock(myMutex);
+        for (std::size_t i = 0; (i < myIdle.size()); ++i) {
+            ::SQLFreeHandle(SQL_HANDLE_STMT, myIdle[i].handle);
+        }
+        myIdle.clear();
+    }
+
+    ::SQLHANDLE Connection::acquire_statement ()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(myMutex);
+            expire_statements(std::chrono::steady_clock::now());
+            if (!myIdle.empty())
+            {
+                    // Most recently used first, so old ones can expire.
+                const ::SQLHANDLE value = myIdle.back().handle;
+                myIdle.pop_back();
+                return (value);
+            }
+        }
+        ::SQLHANDLE value = SQL_NULL_HANDLE;
+        const ::SQLRETURN result = ::SQLAllocHandle(
+            SQL_HANDLE_STMT, handle().value(), &value
+            );
+        if (result != SQL_SUCCESS) {
+            throw (Diagnostic(handle()));
+        }
+        return (value);
+    }
+
+    void Connection::release_statement (::SQLHANDLE value) throw()
+    {
+        if (value == SQL_NULL_HANDLE) {
+            return;
+        }
+        const std::lock_guard<std::mutex> lock(myMutex);
+        const std::chrono::steady_clock::time_point now =
+            std::chrono::steady_clock::now();
+        expire_statements(now);
+            // Restore what the next user expects of a fresh handle; free
+            // handles that cannot be restored.
+        const ::SQLPOINTER synchronous =
+            reinterpret_cast< ::SQLPOINTER >(SQL_ASYNC_ENABLE_OFF);
+        if ((myIdle.size() < myIdleLimit) &&
+            (::SQLFreeStmt(value, SQL_CLOSE) == SQL_SUCCESS) &&
+            (::SQLFreeStmt(value, SQL_UNBIND) == SQL_SUCCESS) &&
+            (::SQLFreeStmt(value, SQL_RESET_PARAMS) == SQL_SUCCESS) &&
+            (::SQLSetStmtAttr(value, SQL_ATTR_ASYNC_ENABLE,
+                              synchronous, 0) == SQL_SUCCESS))
+        {
+            const Idle idle = { value, now };
+            myIdle.push_back(idle);
+            return;
+        }
+        ::SQLFreeHandle(SQL_HANDLE_STMT, value);
+    }
+
+    void Connection::expire_statements
+        (std::chrono::steady_clock::time_point now)
+    {
+        while (!myIdle.empty() && (now-myIdle.front().since > myIdleTimeout))
+        {
+            ::SQLFreeHandle(SQL_HANDLE_STMT, myIdle.front().handle);
+            myIdle.pop_front();
+        }
+    }
+
 }
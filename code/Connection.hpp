@@ -32,6 +32,9 @@
 #include "Handle.hpp"
 #include "NotCopyable.hpp"
 #include "string.hpp"
+#include <chrono>
+#include <deque>
+#include <mutex>
 
 // TODO: Implement connection classes to use SQLConnect() and
 // SQLBrowseConnect(). The former uses ODBC data sources registered on the
@@ -78,6 +81,17 @@ namespace sql {
         // Hold (and automagically release) the connection data.
         Handle myHandle;
 
+        // Idle statement handles, oldest first.
+        struct Idle
+        {
+            ::SQLHANDLE handle;
+            std::chrono::steady_clock::time_point since;
+        };
+        std::mutex myMutex;
+        std::deque<Idle> myIdle;
+        std::size_t myIdleLimit;
+        std::chrono::seconds myIdleTimeout;
+
         /* construction. */
     protected:
         /*!
@@ -134,6 +148,14 @@ namespace sql {
          */
         void disable_autocommit ();
 
+        /*!
+         * @brief Checks if SQL statements are committed automatically.
+         *
+         * @see enable_autocommit()
+         * @see disable_autocommit()
+         */
+        bool autocommit () const;
+
         /*!
          * @brief Commits all changes made through this connection.
          *
@@ -209,6 +231,50 @@ namespace sql {
          * Tables enumerator.
          */
         uint16 max_table_name_size () const;
+
+        /*!
+         * @brief Configure the pool of idle statement handles.
+         * @param count Maximum number of idle handles to keep, 0 to
+         *  allocate and free a handle for each statement.
+         * @param timeout Release handles left idle for this many seconds.
+         *
+         * Statements draw their handle from this pool and return it when
+         * they are destroyed, so short-lived statements (e.g. through
+         * @c sql::execute()) need not allocate a handle each time.  By
+         * default, up to 16 handles are kept for up to 60 seconds.
+         */
+        void pool_statements (std::size_t count, uint32 timeout=60);
+
+        /*!
+         * @brief Count the statement handles currently kept idle.
+         */
+        std::size_t idle_statements ();
+
+        /*!
+         * @brief Free all idle statement handles.
+         *
+         * Connection classes must call this before disconnecting.
+         */
+        void release_statements ();
+
+        /*!
+         * @internal
+         * @brief Obtain a statement handle, idle or newly allocated.
+         */
+        ::SQLHANDLE acquire_statement ();
+
+        /*!
+         * @internal
+         * @brief Return a statement handle for reuse.
+         *
+         * The handle's cursor is closed, its columns and parameters are
+         * unbound and asynchronous mode is switched off.  Handles that
+         * cannot be reset, or that exceed the pool's limit, are freed.
+         */
+        void release_statement (::SQLHANDLE handle) throw();
+
+    private:
+        void expire_statements (std::chrono::steady_clock::time_point now);
     };
 
 }
@@ -0,0 +1,320 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "ConnectionPool.hpp"
+#include "Connection.hpp"
+#include "Status.hpp"
+#include "execute.hpp"
+#include <stdexcept>
+
+namespace sql {
+
+    ConnectionPool::ConnectionPool (Factory factory,
+                                    size_t minimum, size_t maximum)
+        : myFactory(factory)
+        , myMinimum(minimum)
+        , myMaximum(maximum)
+        , myLifetime(0)
+        , myValidation(30)
+        , myQuery()
+        , myMutex()
+        , myReleased()
+        , myIdle()
+        , mySize(0)
+    {
+        if ((maximum < 1) || (minimum > maximum)) {
+            throw (std::invalid_argument(
+                "sql::ConnectionPool: invalid pool size."
+                ));
+        }
+        try {
+            std::unique_lock<std::mutex> lock(myMutex);
+            while (mySize < myMinimum)
+            {
+                Entry entry;
+                open(entry, lock);
+                entry.returned = entry.created;
+                myIdle.push_back(entry);
+            }
+        }
+        catch ( ... ) {
+            for (std::size_t i = 0; (i < myIdle.size()); ++i) {
+                delete myIdle[i].connection;
+            }
+            throw;
+        }
+    }
+
+    ConnectionPool::~ConnectionPool ()
+    {
+        for (std::size_t i = 0; (i < myIdle.size()); ++i) {
+            delete myIdle[i].connection;
+        }
+    }
+
+    ConnectionPool::Lease ConnectionPool::acquire ()
+    {
+        Lease lease;
+        std::unique_lock<std::mutex> lock(myMutex);
+        while (!take(lease.myEntry, lock)) {
+            myReleased.wait(lock);
+        }
+        lease.myPool = this;
+        return (lease);
+    }
+
+    bool ConnectionPool::try_acquire (Lease& lease,
+                                      std::chrono::milliseconds timeout)
+    {
+        const Clock::time_point deadline = Clock::now() + timeout;
+        Entry entry;
+        std::unique_lock<std::mutex> lock(myMutex);
+        while (!take(entry, lock))
+        {
+            if (myReleased.wait_until(lock, deadline) ==
+                std::cv_status::timeout)
+            {
+                if (!take(entry, lock)) {
+                    return (false);
+                }
+                break;
+            }
+        }
+        lock.unlock();
+        lease.release();
+        lease.myPool = this, lease.myEntry = entry, lease.myBroken = false;
+        return (true);
+    }
+
+    void ConnectionPool::max_lifetime (uint32 seconds)
+    {
+        const std::lock_guard<std::mutex> lock(myMutex);
+        myLifetime = std::chrono::seconds(seconds);
+    }
+
+    void ConnectionPool::validate_after (uint32 seconds, const string& query)
+    {
+        const std::lock_guard<std::mutex> lock(myMutex);
+        myValidation = std::chrono::seconds(seconds);
+        myQuery = query;
+    }
+
+    size_t ConnectionPool::size ()
+    {
+        const std::lock_guard<std::mutex> lock(myMutex);
+        return (mySize);
+    }
+
+    size_t ConnectionPool::idle ()
+    {
+        const std::lock_guard<std::mutex> lock(myMutex);
+        return (myIdle.size());
+    }
+
+    bool ConnectionPool::take (Entry& entry,
+                               std::unique_lock<std::mutex>& lock)
+    {
+            // Most recently returned first, so extra connections go stale
+            // and expire.
+        while (!myIdle.empty())
+        {
+            entry = myIdle.back();
+            myIdle.pop_back();
+            const Clock::time_point now = Clock::now();
+            const bool expired = (myLifetime.count() > 0) &&
+                (now-entry.created >= myLifetime);
+            const bool stale = (now-entry.returned >= myValidation);
+            if (!expired && !stale) {
+                return (true);
+            }
+
+                // Don't hold the lock during driver calls.
+            const string query = myQuery;
+            lock.unlock();
+            const bool valid =
+                !expired && validate(*entry.connection, query);
+            if (!valid) {
+                delete entry.connection;
+            }
+            lock.lock();
+            if (valid) {
+                return (true);
+            }
+            --mySize;
+        }
+        if (mySize < myMaximum) {
+            open(entry, lock);
+            return (true);
+        }
+        return (false);
+    }
+
+    bool ConnectionPool::validate (Connection& connection,
+                                   const string& query) const
+    {
+        try {
+            if (query.length() > 0) {
+                execute(connection, query);
+                return (true);
+            }
+            ::SQLUINTEGER dead = SQL_CD_TRUE;
+            const ::SQLRETURN result = ::SQLGetConnectAttr(
+                connection.handle().value(), SQL_ATTR_CONNECTION_DEAD,
+                &dead, 0, 0
+                );
+            if (result == SQL_ERROR)
+            {
+                    // Drivers that cannot tell are assumed to be alive.
+                const Status status(connection.handle());
+                return ((status == Status::not_implemented()) ||
+                        (status == Status::invalid_attribute()));
+            }
+            return ((result == SQL_SUCCESS) && (dead == SQL_CD_FALSE));
+        }
+        catch ( ... ) {
+            return (false);
+        }
+    }
+
+    void ConnectionPool::open (Entry& entry,
+                               std::unique_lock<std::mutex>& lock)
+    {
+            // Reserve the slot, then connect without holding the lock.
+        ++mySize;
+        lock.unlock();
+        try {
+            entry.connection = myFactory();
+        }
+        catch ( ... ) {
+            lock.lock();
+            --mySize;
+            myReleased.notify_one();
+            throw;
+        }
+        entry.created = Clock::now();
+        entry.returned = entry.created;
+        lock.lock();
+    }
+
+    void ConnectionPool::replenish (std::unique_lock<std::mutex>& lock)
+    {
+            // Best effort: connections are also opened on demand.
+        try {
+            while (mySize < myMinimum)
+            {
+                Entry entry;
+                open(entry, lock);
+                myIdle.push_back(entry);
+                myReleased.notify_one();
+            }
+        }
+        catch ( ... ) {
+        }
+    }
+
+    void ConnectionPool::release (const Entry& entry, bool discard)
+    {
+        std::unique_lock<std::mutex> lock(myMutex);
+        const Clock::time_point now = Clock::now();
+        const bool expired = (myLifetime.count() > 0) &&
+            (now-entry.created >= myLifetime);
+        if (discard || expired)
+        {
+            --mySize;
+            lock.unlock();
+            myReleased.notify_one();
+            delete entry.connection;
+            lock.lock();
+            replenish(lock);
+            return;
+        }
+        myIdle.push_back(entry);
+        myIdle.back().returned = now;
+        lock.unlock();
+        myReleased.notify_one();
+    }
+
+    ConnectionPool::Lease::Lease ()
+        : myPool(0), myEntry(), myBroken(false)
+    {
+    }
+
+    ConnectionPool::Lease::Lease (Lease&& other)
+        : myPool(other.myPool), myEntry(other.myEntry)
+        , myBroken(other.myBroken)
+    {
+        other.myPool = 0;
+    }
+
+    ConnectionPool::Lease::~Lease ()
+    {
+        release();
+    }
+
+    bool ConnectionPool::Lease::valid () const
+    {
+        return (myPool != 0);
+    }
+
+    Connection& ConnectionPool::Lease::connection () const
+    {
+        if (myPool == 0) {
+            throw (std::logic_error(
+                "sql::ConnectionPool::Lease: no connection."
+                ));
+        }
+        return (*myEntry.connection);
+    }
+
+    void ConnectionPool::Lease::discard ()
+    {
+        myBroken = true;
+    }
+
+    void ConnectionPool::Lease::release ()
+    {
+        if (myPool != 0)
+        {
+            ConnectionPool *const pool = myPool;
+            myPool = 0;
+            pool->release(myEntry, myBroken);
+        }
+    }
+
+    ConnectionPool::Lease& ConnectionPool::Lease::operator=
+        (Lease&& other)
+    {
+        if (&other != this)
+        {
+            release();
+            myPool = other.myPool, myEntry = other.myEntry;
+            myBroken = other.myBroken;
+            other.myPool = 0;
+        }
+        return (*this);
+    }
+
+}
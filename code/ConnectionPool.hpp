@@ -0,0 +1,253 @@
+#ifndef _sql_ConnectionPool_hpp__
+#define _sql_ConnectionPool_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+#include "types.hpp"
+#include "string.hpp"
+#include "NotCopyable.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace sql {
+
+    class Connection;
+
+    /*!
+     * @brief Thread-safe pool of database connections.
+     *
+     * Connecting is expensive.  Threads that need a connection for a short
+     * while can lease one from the pool instead, and return it when done:
+     * @code
+     *  sql::ConnectionPool pool([&environment] () -> sql::Connection* {
+     *      return (new sql::sqlite::Connection(environment, "test.db"));
+     *  }, 2, 16);
+     *  // ...
+     *  sql::ConnectionPool::Lease lease = pool.acquire();
+     *  sql::execute(*lease, "delete from sessions;");
+     * @endcode
+     *
+     * Connections are opened by the factory, up to the pool's maximum size,
+     * and idle ones are reused most recent first.  The pool keeps at least
+     * its minimum size open: connections that are closed when returned
+     * are replaced right away.  Connections older than
+     * the maximum lifetime are closed instead of being reused, and
+     * connections that sat idle for a while are validated before being
+     * handed out again.
+     *
+     * All leases must be returned before the pool is destroyed.
+     */
+    class ConnectionPool :
+        private NotCopyable
+    {
+        /* nested types. */
+    public:
+        /*!
+         * @brief Function that opens a new connection.
+         */
+        typedef std::function<Connection*()> Factory;
+
+        typedef std::chrono::steady_clock Clock;
+
+        class Lease;
+
+    private:
+        struct Entry
+        {
+            Connection * connection;
+            Clock::time_point created;
+            Clock::time_point returned;
+        };
+
+        /* data. */
+    private:
+        Factory myFactory;
+        size_t myMinimum;
+        size_t myMaximum;
+        std::chrono::seconds myLifetime;
+        std::chrono::seconds myValidation;
+        string myQuery;
+
+        std::mutex myMutex;
+        std::condition_variable myReleased;
+        std::deque<Entry> myIdle;
+        size_t mySize;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Open @a minimum connections.
+         * @param factory Opens a new connection, owned by the pool.
+         * @param minimum Number of connections opened up front, and kept
+         *  open afterwards.
+         * @param maximum Maximum number of connections open at once.
+         */
+        ConnectionPool (Factory factory, size_t minimum=1, size_t maximum=8);
+
+        /*!
+         * @brief Close all idle connections.
+         */
+        ~ConnectionPool ();
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Lease a connection, waiting for one if needed.
+         */
+        Lease acquire ();
+
+        /*!
+         * @brief Lease a connection, waiting at most @a timeout for one.
+         * @return @c false if no connection became available in time.
+         */
+        bool try_acquire (Lease& lease, std::chrono::milliseconds timeout
+                          =std::chrono::milliseconds(0));
+
+        /*!
+         * @brief Close connections once they are @a seconds old.
+         *
+         * This makes the pool reconnect from time to time, so that long
+         * lived connections do not accumulate server-side resources.  The
+         * default, 0, keeps connections for as long as they work.
+         */
+        void max_lifetime (uint32 seconds);
+
+        /*!
+         * @brief Validate connections left idle for @a seconds or more.
+         * @param seconds Idle time before validation; 0 validates each time.
+         * @param query Statement used to validate the connection.  When
+         *  empty, the driver is asked if the connection is dead, which does
+         *  not require a round trip to the database.  Connections of
+         *  drivers that do not support the question are assumed alive.
+         *
+         * By default, connections idle for 30 seconds are validated using
+         * the driver's @c SQL_ATTR_CONNECTION_DEAD attribute.
+         */
+        void validate_after (uint32 seconds, const string& query=string());
+
+        /*!
+         * @brief Maximum number of connections open at once.
+         */
+        size_t maximum () const {
+            return (myMaximum);
+        }
+
+        /*!
+         * @brief Number of connections currently open, leased or not.
+         */
+        size_t size ();
+
+        /*!
+         * @brief Number of connections waiting to be leased.
+         */
+        size_t idle ();
+
+    private:
+        bool take (Entry& entry, std::unique_lock<std::mutex>& lock);
+        bool validate (Connection& connection, const string& query) const;
+        void open (Entry& entry, std::unique_lock<std::mutex>& lock);
+        void replenish (std::unique_lock<std::mutex>& lock);
+        void release (const Entry& entry, bool discard);
+    };
+
+    /*!
+     * @brief Connection leased from a pool, returned when destroyed.
+     */
+    class ConnectionPool::Lease
+    {
+    friend class ConnectionPool;
+
+        /* data. */
+    private:
+        ConnectionPool * myPool;
+        Entry myEntry;
+        bool myBroken;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Create an empty lease, to pass to @c try_acquire().
+         */
+        Lease ();
+
+        /*!
+         * @brief Take over @a other's connection.
+         */
+        Lease (Lease&& other);
+
+        /*!
+         * @brief Return the connection to the pool.
+         */
+        ~Lease ();
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Check if the lease holds a connection.
+         */
+        bool valid () const;
+
+        /*!
+         * @brief Access the leased connection.
+         */
+        Connection& connection () const;
+
+        /*!
+         * @brief Close the connection instead of returning it to the pool.
+         *
+         * Use this when the connection is known to be broken.
+         */
+        void discard ();
+
+        /*!
+         * @brief Return the connection to the pool now.
+         */
+        void release ();
+
+        /* operators. */
+    public:
+        /*!
+         * @brief Take over @a other's connection, returning the current one.
+         */
+        Lease& operator= (Lease&& other);
+
+        Connection& operator* () const {
+            return (connection());
+        }
+
+        Connection * operator-> () const {
+            return (&connection());
+        }
+    };
+
+}
+
+#endif /* _sql_ConnectionPool_hpp__ */
@@ -60,6 +60,8 @@ namespace sql {
 
     Driver::~Driver ()
     {
+            // Disconnecting frees the statement handles.
+        release_statements();
         ::SQLDisconnect(handle().value());
     }
 
@@ -42,6 +42,18 @@ namespace {
         return (handle);
     }
 
+        // Enables pooling, which must precede allocation.
+    ::SQLHANDLE allocate (const sql::Pooling& pooling)
+    {
+        const ::SQLRETURN result = ::SQLSetEnvAttr(
+            SQL_NULL_HANDLE, SQL_ATTR_CONNECTION_POOLING, pooling.value(), 0
+            );
+        if ((result != SQL_SUCCESS) && (result != SQL_SUCCESS_WITH_INFO)) {
+            throw (sql::Environment::Failure());
+        }
+        return (allocate());
+    }
+
 }
 
 namespace sql {
@@ -57,11 +69,36 @@ namespace sql {
         }
     }
 
+    Environment::Environment (const Pooling& pooling,
+                              const Version& version)
+        : myHandle(::allocate(pooling), SQL_HANDLE_ENV, &Handle::claim)
+    {
+        const ::SQLRETURN result = ::SQLSetEnvAttr(
+            myHandle.value(), SQL_ATTR_ODBC_VERSION, version.value(), 0
+            );
+        if (result != SQL_SUCCESS) {
+            throw (Diagnostic(myHandle));
+        }
+    }
+
     const Handle& Environment::handle () const throw()
     {
         return (myHandle);
     }
 
+    void Environment::relaxed_matching (bool relaxed)
+    {
+        const ::SQLPOINTER match = reinterpret_cast< ::SQLPOINTER >(
+            relaxed? SQL_CP_RELAXED_MATCH : SQL_CP_STRICT_MATCH
+            );
+        const ::SQLRETURN result = ::SQLSetEnvAttr(
+            handle().value(), SQL_ATTR_CP_MATCH, match, 0
+            );
+        if (result != SQL_SUCCESS) {
+            throw (Diagnostic(handle()));
+        }
+    }
+
     void Environment::commit ()
     {
         const ::SQLRETURN result = ::SQLEndTran(
@@ -30,6 +30,7 @@
 #include "__configure__.hpp"
 #include "NotCopyable.hpp"
 #include "Handle.hpp"
+#include "Pooling.hpp"
 #include "Version.hpp"
 
 namespace sql {
@@ -72,6 +73,24 @@ namespace sql {
              */
         Environment (const Version& version = Version::odbc3);
 
+            /*!
+             * @brief Create an SQL/ODBC environment with driver manager
+             *    connection pooling.
+             *
+             * The pooling mode is a process-wide setting: it applies to every
+             * environment created from now on, not only to this one.  Closing
+             * a Connection then returns its native connection to the driver
+             * manager, which reuses it for the next connection with matching
+             * settings.
+             *
+             * @param pooling Pooling mode to enable (or disable).
+             * @param version ODBC Version to use, defaults to '3.x'.
+             *
+             * @see relaxed_matching()
+             */
+        explicit Environment (const Pooling& pooling,
+                              const Version& version = Version::odbc3);
+
         /* methods. */
     public:
             /*!
@@ -86,6 +105,16 @@ namespace sql {
              */
         const Handle& handle () const throw();
 
+            /*!
+             * @brief Selects how pooled connections are matched.
+             *
+             * With strict matching (the default), a pooled connection is only
+             * reused for identical connection strings.  Relaxed matching
+             * only compares the attributes that affect the connection's
+             * identity, making more connections eligible for reuse.
+             */
+        void relaxed_matching (bool relaxed);
+
             /*!
              * @brief Commits all changes made through this environment.
              */
@@ -0,0 +1,134 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Execution.hpp"
+#include <chrono>
+#include <thread>
+
+namespace {
+
+    void execute (sql::Statement * statement)
+    {
+        statement->execute();
+    }
+
+}
+
+namespace sql {
+
+    Execution::Execution (Statement& statement)
+        : myStatement(statement)
+        , myNative(statement.asynchronous(true))
+        , myDone(false)
+        , myFuture()
+    {
+        if (!myNative)
+        {
+            myFuture = std::async(
+                std::launch::async, &::execute, &myStatement
+                );
+            return;
+        }
+        try {
+            myDone = myStatement.start();
+        }
+        catch ( ... ) {
+            finish();
+            throw;
+        }
+        if (myDone) {
+            finish();
+        }
+    }
+
+    Execution::~Execution ()
+    {
+        try {
+            wait();
+        }
+        catch ( ... ) {
+        }
+    }
+
+    Statement& Execution::statement () const
+    {
+        return (myStatement);
+    }
+
+    bool Execution::native () const
+    {
+        return (myNative);
+    }
+
+    bool Execution::ready ()
+    {
+        if (myDone) {
+            return (true);
+        }
+        if (!myNative)
+        {
+            const std::future_status status =
+                myFuture.wait_for(std::chrono::seconds(0));
+            if (status != std::future_status::ready) {
+                return (false);
+            }
+            myDone = true, myFuture.get();
+            return (true);
+        }
+        try {
+            myDone = myStatement.poll();
+        }
+        catch ( ... ) {
+            myDone = true, finish();
+            throw;
+        }
+        if (myDone) {
+            finish();
+        }
+        return (myDone);
+    }
+
+    void Execution::wait ()
+    {
+        if (!myNative)
+        {
+            if (!myDone) {
+                myDone = true, myFuture.get();
+            }
+            return;
+        }
+        while (!ready()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    void Execution::finish ()
+    {
+            // Other operations (e.g. fetching results) are synchronous.
+        myStatement.asynchronous(false);
+    }
+
+}
@@ -0,0 +1,114 @@
+#ifndef _sql_Execution_hpp__
+#define _sql_Execution_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+#include "types.hpp"
+#include "NotCopyable.hpp"
+#include "Statement.hpp"
+#include <future>
+
+namespace sql {
+
+    /*!
+     * @brief Statement execution that does not block the caller.
+     *
+     * The statement is put in asynchronous mode (@c SQL_ATTR_ASYNC_ENABLE)
+     * and the driver is polled until the execution completes.  For drivers
+     * that do not support asynchronous execution, the statement is executed
+     * in a background thread instead.  Either way, the interface is the
+     * same and a single thread can keep many executions in flight, over
+     * different connections.
+     *
+     * Do not use the statement (nor its connection, with the fallback)
+     * until the execution is complete.  Errors are thrown by @c ready() or
+     * @c wait(), as they would be by @c Statement::execute().
+     *
+     * @code
+     *  sql::Execution execution(statement);
+     *  while (!execution.ready()) {
+     *    // do something else.
+     *  }
+     *  sql::Results results(statement);
+     * @endcode
+     */
+    class Execution :
+        private NotCopyable
+    {
+        /* data. */
+    private:
+        Statement& myStatement;
+        bool myNative;
+        bool myDone;
+
+            // Background execution, when the driver does not support
+            // asynchronous execution.
+        std::future<void> myFuture;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Start executing @a statement.
+         */
+        explicit Execution (Statement& statement);
+
+        /*!
+         * @brief Wait for the execution to complete, ignoring errors.
+         */
+        ~Execution ();
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Access the statement being executed.
+         */
+        Statement& statement () const;
+
+        /*!
+         * @brief Check if the driver executes the statement asynchronously.
+         * @return @c false if the statement runs in a background thread.
+         */
+        bool native () const;
+
+        /*!
+         * @brief Check, without blocking, if the execution is complete.
+         */
+        bool ready ();
+
+        /*!
+         * @brief Block until the execution is complete.
+         */
+        void wait ();
+
+    private:
+        void finish ();
+    };
+
+}
+
+#endif /* _sql_Execution_hpp__ */
@@ -0,0 +1,141 @@
+#ifndef _sql_Output_hpp__
+#define _sql_Output_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+#include "types.hpp"
+#include <memory>
+
+namespace sql {
+
+    /*!
+     * @brief Caller variable bound to an output parameter.
+     *
+     * Stored procedures may return values through output (or input/output)
+     * parameters.  When the statement is executed, the value is written to
+     * the caller's variable, which must remain valid until then.  This
+     * object need not: the statement keeps the length/null indicator and
+     * copies it back to all copies of this object that are still alive.
+     * Strings are received in a buffer of @c capacity() characters, owned
+     * by the statement.
+     *
+     * @code
+     *  sql::int32 total = 0;
+     *  sql::Output<sql::int32> output = sql::out(total);
+     *  statement << sql::int32(7) << output << sql::execute;
+     *  if (!output.null()) {
+     *    // total is set.
+     *  }
+     * @endcode
+     */
+    template<typename T>
+    class Output
+    {
+        /* data. */
+    private:
+        T * myValue;
+        bool myInput;
+        size_t myCapacity;
+        std::shared_ptr< ::SQLLEN > myLength;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Refer to the variable that receives the value.
+         * @param value Caller variable.
+         * @param input @c true to also send @a value's current value.
+         * @param capacity Maximum length of a string value, in characters.
+         */
+        Output (T& value, bool input=false, size_t capacity=256)
+            : myValue(&value)
+            , myInput(input)
+            , myCapacity(capacity)
+            , myLength(std::make_shared< ::SQLLEN >(SQL_NULL_DATA))
+        {}
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Access the caller's variable.
+         */
+        T& value () const {
+            return (*myValue);
+        }
+
+        /*!
+         * @brief Check if the value is also sent to the procedure.
+         */
+        bool input () const {
+            return (myInput);
+        }
+
+        /*!
+         * @brief Maximum length of a string value, in characters.
+         */
+        size_t capacity () const {
+            return (myCapacity);
+        }
+
+        /*!
+         * @brief Check if the value returned by the procedure was null.
+         */
+        bool null () const {
+            return (*myLength == SQL_NULL_DATA);
+        }
+
+        /*!
+         * @internal
+         * @brief Length/indicator, updated by
+         *  @c PreparedStatement::read_outputs().
+         */
+        const std::shared_ptr< ::SQLLEN >& indicator () const {
+            return (myLength);
+        }
+    };
+
+    /*!
+     * @brief Bind @a value to an output parameter.
+     */
+    template<typename T>
+    Output<T> out (T& value, size_t capacity=256)
+    {
+        return (Output<T>(value, false, capacity));
+    }
+
+    /*!
+     * @brief Bind @a value to an input/output parameter.
+     */
+    template<typename T>
+    Output<T> inout (T& value, size_t capacity=256)
+    {
+        return (Output<T>(value, true, capacity));
+    }
+
+}
+
+#endif /* _sql_Output_hpp__ */
@@ -0,0 +1,93 @@
+#ifndef _sql_Pooling_hpp__
+#define _sql_Pooling_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+
+namespace sql {
+
+    /*!
+     * @brief Enumeration of driver manager connection pooling modes.
+     *
+     * With pooling on, the driver manager keeps disconnected connections
+     * open and hands them back to the next matching connect.  How long it
+     * keeps them is a driver setting (e.g. @c CPTimeout in odbcinst.ini).
+     */
+    class Pooling
+    {
+        /* nested types. */
+    public:
+        /*!
+         * @internal
+         * @brief Native representation of pooling values.
+         */
+        typedef ::SQLPOINTER Value;
+
+        /* class data. */
+    public:
+        /*!
+         * @brief No pooling.
+         */
+        static const Pooling off;
+
+        /*!
+         * @brief One pool per driver, shared by all environments.
+         */
+        static const Pooling per_driver;
+
+        /*!
+         * @brief One pool per environment.
+         */
+        static const Pooling per_environment;
+
+        /* members. */
+    private:
+        Value myValue;
+
+        /* construction. */
+    private:
+        /*!
+         * @internal
+         * @brief Build a pooling mode from its native enumeration value.
+         */
+        explicit Pooling (Value value) throw();
+
+        /* methods. */
+    public:
+        /*!
+         * @internal
+         * @brief Obtains the pooling mode's value, in it's native API
+         *    representation.
+         * @return The pooling mode's native value.
+         */
+        Value value () const throw();
+    };
+
+}
+
+#endif /* _sql_Pooling_hpp__ */
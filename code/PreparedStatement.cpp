@@ -32,6 +32,11 @@
 #include "Connection.hpp"
 #include "Diagnostic.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
 // Since ::SQLBindParameter() does not have a const-correct interface. It's 3rd
 // parameter indicates if it should read or write to the given location. If this
 // value is SQL_PARAM_INPUT, the data is not modified, even though it requires
@@ -40,13 +45,179 @@
 
 namespace {
 
-    // Shared between all null values.  Must be available between calls
-    // to PreparedStatement::bind() and PreparedStatement::execute().
-    ::SQLLEN null_value = SQL_NULL_DATA;
+    bool is_name_start (char c)
+    {
+        return (((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z'))
+                || (c == '_'));
+    }
+
+    bool is_name_part (char c)
+    {
+        return (is_name_start(c) || ((c >= '0') && (c <= '9')));
+    }
+
+    // Ordinals of each named placeholder.
+    typedef std::map< std::string, std::vector<sql::uint16> > Names;
+
+    bool is_keyword (const std::string& text, std::string::size_type i,
+                     std::string::size_type stop, const char * keyword)
+    {
+        for (; (i < stop) && (*keyword != '\0'); ++i, ++keyword)
+        {
+            if ((text[i] | 0x20) != *keyword) {
+                return (false);
+            }
+        }
+        return ((i == stop) && (*keyword == '\0'));
+    }
+
+    // Replace named placeholders by '?', recording the ordinal of each
+    // occurrence.  Literals, quoted identifiers and comments are skipped.
+    // With @a variables, "@name" is left alone (T-SQL local variables and
+    // MySQL user variables); otherwise, @a variables is set if the text
+    // looks like it uses them: it contains '?' markers, "declare" or
+    // "set @".  "@@name" (system variables) is never replaced.
+    std::string rewrite (const std::string& text, Names& names,
+                         bool& variables)
+    {
+        const bool placeholders = !variables;
+        std::string result;
+        result.reserve(text.size());
+        sql::uint16 ordinal = 0;
+        std::string::size_type i = 0;
+        while (i < text.size())
+        {
+            const char c = text[i];
+            std::string::size_type stop = i+1;
+            if ((c == '\'') || (c == '"') || (c == '`')) {
+                stop = std::min(text.find(c, i+1), text.size()-1)+1;
+            }
+            else if (text.compare(i, 2, "--") == 0) {
+                stop = std::min(text.find('\n', i), text.size()-1)+1;
+            }
+            else if (text.compare(i, 2, "/*") == 0) {
+                stop = std::min(text.find("*/", i+2), text.size()-2)+2;
+            }
+            else if ((c == ':') && (text.compare(i, 2, "::") == 0)) {
+                stop = i+2;
+            }
+            else if (c == '?') {
+                ++ordinal, variables = true;
+            }
+            else if ((c == '@') && (text.compare(i, 2, "@@") == 0))
+            {
+                stop = i+2;
+                while ((stop < text.size()) && ::is_name_part(text[stop])) {
+                    ++stop;
+                }
+            }
+            else if (::is_name_start(c) &&
+                     ((i == 0) || !::is_name_part(text[i-1])))
+            {
+                while ((stop < text.size()) && ::is_name_part(text[stop])) {
+                    ++stop;
+                }
+                std::string::size_type next = stop;
+                while ((next < text.size()) &&
+                       ((text[next] == ' ') || (text[next] == '\t') ||
+                        (text[next] == '\r') || (text[next] == '\n')))
+                {
+                    ++next;
+                }
+                if (::is_keyword(text, i, stop, "declare") ||
+                    (::is_keyword(text, i, stop, "set") &&
+                     (next < text.size()) && (text[next] == '@')))
+                {
+                    variables = true;
+                }
+            }
+            else if (((c == ':') || ((c == '@') && placeholders)) &&
+                     (i+1 < text.size()) &&
+                     ::is_name_start(text[i+1]) &&
+                     ((i == 0) || !::is_name_part(text[i-1])))
+            {
+                stop = i+1;
+                while ((stop < text.size()) && ::is_name_part(text[stop])) {
+                    ++stop;
+                }
+                names[text.substr(i+1, stop-i-1)].push_back(++ordinal);
+                result += '?', i = stop;
+                continue;
+            }
+            result.append(text, i, stop-i), i = stop;
+        }
+        return (result);
+    }
+
+    // Rewrite, leaving "@name" alone if the text seems to use variables.
+    std::string positional (const std::string& text, Names& names)
+    {
+        bool variables = false;
+        std::string result = rewrite(text, names, variables);
+        if (variables && (text.find('@') != std::string::npos)) {
+            names.clear(), result = rewrite(text, names, variables);
+        }
+        return (result);
+    }
+
+    // Orders named placeholders for binary search.
+    struct NameLess
+    {
+        template<typename Name>
+        bool operator() (const Name& lhs, const char * rhs) const
+        {
+            return (lhs.name.compare(rhs) < 0);
+        }
+    };
+
+    // Copy an output string from the arena to the caller's string.
+    template<typename Char>
+    void receive_string (void * target, const char * data,
+                         ::SQLLEN length, ::SQLLEN width)
+    {
+        const ::SQLLEN unit = sizeof(Char);
+        const Char *const first = reinterpret_cast<const Char*>(data);
+        if (length == SQL_NULL_DATA) {
+            length = 0;
+        }
+        if ((length == SQL_NO_TOTAL) || (length > width-unit)) {
+            length = width-unit;
+        }
+        static_cast<sql::basic_string<Char>*>(target)
+            ->assign(first, first+length/unit);
+    }
+
+    ::SQLPOINTER integer_attribute (::SQLULEN value)
+    {
+        return (reinterpret_cast< ::SQLPOINTER >(value));
+    }
 
-    // Shared between all string parameters.  Must be available between calls
-    // to PreparedStatement::bind() and PreparedStatement::execute().
-    ::SQLLEN null_terminated = SQL_NTS;
+    // Copy values wrapping an ODBC structure into a contiguous array.
+    template<typename T>
+    void copy_values (const std::vector<T>& values, char * buffer)
+    {
+        typedef typename T::Value Value;
+        for (std::size_t i = 0; (i < values.size()); ++i) {
+            std::memcpy(buffer+i*sizeof(Value),
+                        &values[i].value(), sizeof(Value));
+        }
+    }
+
+    // Copy strings into fixed-size, null terminated cells.
+    template<typename Char>
+    void copy_strings (const std::vector< sql::basic_string<Char> >& values,
+                       ::SQLLEN width, char * buffer,
+                       std::vector< ::SQLLEN >& lengths)
+    {
+        const ::SQLLEN unit = sizeof(Char);
+        std::memset(buffer, 0, values.size()*width);
+        lengths.resize(values.size());
+        for (std::size_t i = 0; (i < values.size()); ++i)
+        {
+            lengths[i] = values[i].length()*unit;
+            std::memcpy(buffer+i*width, values[i].data(), lengths[i]);
+        }
+    }
 
 }
 
@@ -54,44 +225,184 @@ namespace sql {
 
     PreparedStatement::PreparedStatement (Connection& connection,
                                           const string& text)
-        : Statement(connection), myNext(1)
+        : Statement(connection), myNext(1), myCount(0), myParameters(-1)
+        , myExecuted(0)
+        , myArraySize(0), myArrays(0), myParamsetSize(1), myProcessed(0)
     {
+        ::Names names;
+        const std::string query =
+            ::positional(std::string(text.c_str(), text.length()), names);
+        for (::Names::iterator name = names.begin();
+             (name != names.end()); ++name)
+        {
+            myNames.push_back(Name());
+            myNames.back().name = name->first;
+            myNames.back().ordinals.swap(name->second);
+        }
+
             // Indicate the statement will be using bound parameters.
         ::SQLRETURN result = ::SQLPrepare(
-            handle().value(), const_cast<character*>(text.data()), SQL_NTS
+            handle().value(),
+            reinterpret_cast<character*>(const_cast<char*>(query.c_str())),
+            SQL_NTS
             );
         if (result != SQL_SUCCESS) {
             throw (Diagnostic(handle()));
         }
     }
 
+    PreparedStatement::~PreparedStatement ()
+    {
+            // The status pointers refer to this object.
+        if (!myStatus.empty())
+        {
+            ::SQLSetStmtAttr(handle().value(),
+                             SQL_ATTR_PARAM_STATUS_PTR, 0, 0);
+            ::SQLSetStmtAttr(handle().value(),
+                             SQL_ATTR_PARAMS_PROCESSED_PTR, 0, 0);
+        }
+        if (myParamsetSize != 1) {
+            ::SQLSetStmtAttr(handle().value(), SQL_ATTR_PARAMSET_SIZE,
+                             ::integer_attribute(1), 0);
+        }
+    }
+
     PreparedStatement& PreparedStatement::execute ()
     {
             // Execute query with currently bound parameters.
         Statement::execute();
-        
+        return (*this);
+    }
+
+    void PreparedStatement::before_execute ()
+    {
+        if ((myArrays > 0) && (myArrays != myCount)) {
+            throw (std::invalid_argument(
+                "sql::PreparedStatement: cannot mix arrays and single values."
+                ));
+        }
+
+            // Bind the parameters, now that the arena no longer moves.  The
+            // driver keeps bindings between executions, so parameters whose
+            // type and buffers are unchanged need not be bound again.
+        const std::size_t count =
+            std::min<std::size_t>(myCount, mySlots.size());
+        for (std::size_t i = 0; (i < count); ++i)
+        {
+            Slot& slot = mySlots[i];
+            ::SQLPOINTER data = const_cast< ::SQLPOINTER >(slot.data);
+            if ((data == 0) && (slot.capacity > 0)) {
+                data = &myArena[slot.offset];
+            }
+            ::SQLLEN * indicator = slot.indicator;
+            if (indicator == 0) {
+                indicator = (myArrays > 0)?
+                    (slot.lengths.empty()? 0 : &slot.lengths[0]) : &slot.length;
+            }
+            const Binding binding = {
+                slot.direction, slot.type, slot.sql_type, slot.size,
+                slot.digits, data, slot.width, indicator
+            };
+            if (slot.bound && (binding == slot.binding)) {
+                continue;
+            }
+            slot.bound = false;
+            const ::SQLRETURN result = ::SQLBindParameter(
+                handle().value(), static_cast< ::SQLUSMALLINT >(i+1),
+                binding.direction, binding.type, binding.sql_type, binding.size,
+                binding.digits, binding.data, binding.width, binding.indicator
+                );
+            if (result != SQL_SUCCESS) {
+                throw (Diagnostic(handle()));
+            }
+            slot.binding = binding;
+            slot.bound = true;
+        }
+
+            // Execute all rows of the parameter arrays at once.
+        const ::SQLULEN size = (myArrays > 0)? myArraySize : 1;
+        if (size > 1)
+        {
+            myStatus.resize(size);
+            myProcessed = 0;
+            ::SQLRETURN result = ::SQLSetStmtAttr(
+                handle().value(), SQL_ATTR_PARAM_STATUS_PTR, &myStatus[0], 0
+                );
+            if (result == SQL_SUCCESS) {
+                result = ::SQLSetStmtAttr(
+                    handle().value(), SQL_ATTR_PARAMS_PROCESSED_PTR,
+                    &myProcessed, 0
+                    );
+            }
+            if (result != SQL_SUCCESS) {
+                throw (Diagnostic(handle()));
+            }
+        }
+        if (size != myParamsetSize)
+        {
+            const ::SQLRETURN result = ::SQLSetStmtAttr(
+                handle().value(), SQL_ATTR_PARAMSET_SIZE,
+                ::integer_attribute(size), 0
+                );
+            if (result != SQL_SUCCESS) {
+                throw (Diagnostic(handle()));
+            }
+            myParamsetSize = size;
+        }
+
+        myExecuted = static_cast<uint16>(count);
+    }
+
+    void PreparedStatement::after_execute ()
+    {
+        read_outputs();
+
             // Prepare for re-execution of the same query.
-        return (reset());
+        reset();
+    }
+
+    void PreparedStatement::put_data (::SQLPOINTER token)
+    {
+        const Stream& stream = *static_cast<const Stream*>(token);
+        if (myChunk.empty()) {
+            myChunk.resize(65536);
+        }
+
+            // Stop at the announced length, even if the source has more.
+            // Empty values are still sent, as a single empty chunk.
+        std::size_t remaining = stream.length();
+        std::size_t size = 0;
+        do {
+            size = (remaining == 0)? 0 : stream.read(
+                &myChunk[0], std::min(myChunk.size(), remaining)
+                );
+            const ::SQLRETURN result =
+                ::SQLPutData(handle().value(), &myChunk[0], size);
+            if ((result != SQL_SUCCESS) && (result != SQL_SUCCESS_WITH_INFO)) {
+                throw (Diagnostic(handle()));
+            }
+            remaining -= size;
+        }
+        while ((size > 0) && (remaining > 0));
     }
 
     int16 PreparedStatement::parameter_count () const
     {
+        if (myParameters >= 0) {
+            return (myParameters);
+        }
         ::SQLSMALLINT count = 0;
         const ::SQLRETURN result = ::SQLNumParams(handle().value(), &count);
         if (result != SQL_SUCCESS) {
             throw (Diagnostic(handle()));
         }
+        myParameters = count;
         return (count);
     }
 
     int16 PreparedStatement::column_count () const
     {
-        ::SQLSMALLINT count = 0;
-        const ::SQLRETURN result = ::SQLNumResultCols(handle().value(), &count);
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
-        return (count);
+        return (static_cast<int16>(columns().size()));
     }
 
     bool PreparedStatement::generated_results () const
@@ -101,232 +412,531 @@ namespace sql {
 
     PreparedStatement& PreparedStatement::reset ()
     {
-        myNext = 1; return (*this);
+        myArraySize = 0, myArrays = 0, myStreams.clear();
+        myNext = 1, myCount = 0; return (*this);
     }
 
     PreparedStatement& PreparedStatement::bind (const Null&)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT,
-            0, 0, 0, 0, 0, 0, &::null_value
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
+        Slot& slot = next_slot();
+        slot.type = 0, slot.sql_type = 0, slot.size = 0, slot.digits = 0;
+        slot.data = 0, slot.width = 0, slot.indicator = 0;
+        slot.length = SQL_NULL_DATA;
         ++myNext; return (*this);
     }
 
     PreparedStatement& PreparedStatement::bind (const int8& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_STINYINT,
-            SQL_TINYINT, 0, 0, const_cast<int8*>(&value), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
-        ++myNext; return (*this);
+        return (bind_value(SQL_C_STINYINT, SQL_TINYINT, 0,
+                           &value, sizeof(value)));
     }
 
     PreparedStatement& PreparedStatement::bind (const uint8& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_UTINYINT,
-            SQL_TINYINT, 0, 0, const_cast<uint8*>(&value), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
-        ++myNext; return (*this);
+        return (bind_value(SQL_C_UTINYINT, SQL_TINYINT, 0,
+                           &value, sizeof(value)));
     }
 
     PreparedStatement& PreparedStatement::bind (const int16& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_SSHORT,
-            SQL_SMALLINT, 0, 0, const_cast<int16*>(&value), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
-        ++myNext; return (*this);
+        return (bind_value(SQL_C_SSHORT, SQL_SMALLINT, 0,
+                           &value, sizeof(value)));
     }
 
     PreparedStatement& PreparedStatement::bind (const uint16& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_USHORT,
-            SQL_SMALLINT, 0, 0, const_cast<uint16*>(&value), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
-        ++myNext; return (*this);
+        return (bind_value(SQL_C_USHORT, SQL_SMALLINT, 0,
+                           &value, sizeof(value)));
     }
 
     PreparedStatement& PreparedStatement::bind (const int32& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_SLONG,
-            SQL_INTEGER, 0, 0, const_cast<int32*>(&value), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
-        ++myNext; return (*this);
+        return (bind_value(SQL_C_SLONG, SQL_INTEGER, 0,
+                           &value, sizeof(value)));
     }
 
     PreparedStatement& PreparedStatement::bind (const uint32& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_ULONG, SQL_INTEGER,
-            0, 0, const_cast<uint32*>(&value), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
-        ++myNext; return (*this);
+        return (bind_value(SQL_C_ULONG, SQL_INTEGER, 0,
+                           &value, sizeof(value)));
     }
 
     PreparedStatement& PreparedStatement::bind (const int64& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_SBIGINT,
-            SQL_BIGINT, 0, 0, const_cast<int64*>(&value), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
-        ++myNext; return (*this);
+        return (bind_value(SQL_C_SBIGINT, SQL_BIGINT, 0,
+                           &value, sizeof(value)));
     }
 
     PreparedStatement& PreparedStatement::bind (const uint64& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_UBIGINT,
-            SQL_BIGINT, 0, 0, const_cast<uint64*>(&value), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
-        ++myNext; return (*this);
+        return (bind_value(SQL_C_UBIGINT, SQL_BIGINT, 0,
+                           &value, sizeof(value)));
     }
 
     PreparedStatement& PreparedStatement::bind (const float& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_FLOAT, SQL_REAL,
-            0, 0, const_cast<float*>(&value), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
-        ++myNext; return (*this);
+        return (bind_value(SQL_C_FLOAT, SQL_REAL, 0,
+                           &value, sizeof(value)));
     }
 
     PreparedStatement& PreparedStatement::bind (const double& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_DOUBLE, SQL_DOUBLE,
-            0, 0, const_cast<double*>(&value), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
-        ++myNext; return (*this);
+        return (bind_value(SQL_C_DOUBLE, SQL_DOUBLE, 0,
+                           &value, sizeof(value)));
     }
 
     PreparedStatement& PreparedStatement::bind (const string& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_CHAR,
-            value.length(), 0, const_cast<character*>(value.data()), 0,
-            &::null_terminated
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
+            // Declare the slot's capacity, so the binding can be reused by
+            // shorter values.
+        Slot& slot = store(SQL_C_CHAR, SQL_VARCHAR, 0, value.data(),
+                           value.length()*sizeof(character));
+        slot.size = std::max<std::size_t>(slot.capacity/sizeof(character), 1);
         ++myNext; return (*this);
     }
 
     PreparedStatement& PreparedStatement::bind (const wstring& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_WCHAR, SQL_WCHAR,
-            value.length(), 0, const_cast<wcharacter*>(value.data()), 0,
-            &::null_terminated
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
+        Slot& slot = store(SQL_C_WCHAR, SQL_WVARCHAR, 0, value.data(),
+                           value.length()*sizeof(wcharacter));
+        slot.size = std::max<std::size_t>(slot.capacity/sizeof(wcharacter), 1);
         ++myNext; return (*this);
     }
 
-    PreparedStatement& PreparedStatement::bind (const Date& date)
+    PreparedStatement& PreparedStatement::bind (const Bytes& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_TYPE_DATE,
-            SQL_TYPE_DATE, SQL_DATE_LEN, 0,
-            const_cast<::SQL_DATE_STRUCT*>(&date.value()), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
+            // Sent straight from the caller's buffer.  The length is copied,
+            // because the wrapper itself may be gone by execution time.
+        const ::SQLLEN size = value.size();
+        Slot& slot = next_slot();
+        slot.type = SQL_C_BINARY, slot.sql_type = SQL_VARBINARY;
+        slot.size = (size > 0)? size : 1, slot.digits = 0;
+        slot.data = value.data(), slot.width = size;
+        slot.indicator = 0;
+        slot.length = value.null()? SQL_NULL_DATA : size;
         ++myNext; return (*this);
     }
 
-    PreparedStatement& PreparedStatement::bind (const Guid& guid)
+    PreparedStatement& PreparedStatement::bind (const Stream& value)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_GUID,
-            SQL_GUID, sizeof(::SQLGUID), 0,
-            const_cast<::SQLGUID*>(&guid.value()), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
+            // The driver hands the data pointer back when it needs the value.
+        const ::SQLLEN length = value.length();
+        Slot& slot = next_slot();
+        if (value.binary()) {
+            slot.type = SQL_C_BINARY, slot.sql_type = SQL_LONGVARBINARY;
         }
+        else {
+            slot.type = SQL_C_CHAR, slot.sql_type = SQL_LONGVARCHAR;
+        }
+        slot.size = (length >= 0)? length : 0, slot.digits = 0;
+        myStreams.push_back(value);
+        slot.data = &myStreams.back(), slot.width = 0, slot.indicator = 0;
+        slot.length = (length >= 0)?
+            SQL_LEN_DATA_AT_EXEC(length) : SQL_DATA_AT_EXEC;
         ++myNext; return (*this);
     }
 
+    PreparedStatement& PreparedStatement::bind (const Date& date)
+    {
+        return (bind_value(SQL_C_TYPE_DATE, SQL_TYPE_DATE, SQL_DATE_LEN,
+                           &date.value(), sizeof(Date::Value)));
+    }
+
+    PreparedStatement& PreparedStatement::bind (const Guid& guid)
+    {
+        return (bind_value(SQL_C_GUID, SQL_GUID, sizeof(::SQLGUID),
+                           &guid.value(), sizeof(Guid::Value)));
+    }
+
     PreparedStatement& PreparedStatement::bind (const Numeric& numeric)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_NUMERIC,
-            SQL_NUMERIC, sizeof(::SQL_NUMERIC_STRUCT), 0,
-            const_cast<::SQL_NUMERIC_STRUCT*>(&numeric.value()), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
-        ++myNext; return (*this);
+        return (bind_value(SQL_C_NUMERIC, SQL_NUMERIC,
+                           sizeof(::SQL_NUMERIC_STRUCT),
+                           &numeric.value(), sizeof(Numeric::Value)));
     }
 
     PreparedStatement& PreparedStatement::bind (const Time& time)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_TYPE_TIME,
-            SQL_TYPE_TIME, SQL_TIME_LEN, 0,
-            const_cast<::SQL_TIME_STRUCT*>(&time.value()), 0, 0
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
-        }
-        ++myNext; return (*this);
+        return (bind_value(SQL_C_TYPE_TIME, SQL_TYPE_TIME, SQL_TIME_LEN,
+                           &time.value(), sizeof(Time::Value)));
     }
 
     PreparedStatement& PreparedStatement::bind (const Timestamp& timestamp)
     {
-        ::SQLRETURN result = ::SQLBindParameter(
-            handle().value(), myNext, SQL_PARAM_INPUT, SQL_C_TYPE_TIMESTAMP,
-            SQL_TYPE_TIMESTAMP, sizeof(::SQL_TIMESTAMP_STRUCT), 0,
-            const_cast<::SQL_TIMESTAMP_STRUCT*>(&timestamp.value()), 0, 0
+        return (bind_value(SQL_C_TYPE_TIMESTAMP, SQL_TYPE_TIMESTAMP,
+                           sizeof(::SQL_TIMESTAMP_STRUCT),
+                           &timestamp.value(), sizeof(Timestamp::Value)));
+    }
+
+    std::string PreparedStatement::positional (const std::string& text)
+    {
+        ::Names names;
+        return (::positional(text, names));
+    }
+
+    bool PreparedStatement::has_parameter (const char * name) const
+    {
+        const std::vector<Name>::const_iterator match = std::lower_bound(
+            myNames.begin(), myNames.end(), name, ::NameLess()
             );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(handle()));
+        return ((match != myNames.end()) && (match->name == name));
+    }
+
+    const std::vector<uint16>& PreparedStatement::parameter
+        (const char * name) const
+    {
+        const std::vector<Name>::const_iterator match = std::lower_bound(
+            myNames.begin(), myNames.end(), name, ::NameLess()
+            );
+        if ((match == myNames.end()) || (match->name != name)) {
+            throw (std::invalid_argument(
+                "sql::PreparedStatement: unknown parameter name."
+                ));
+        }
+        return (match->ordinals);
+    }
+
+    PreparedStatement::Slot& PreparedStatement::next_slot ()
+    {
+        if (myArrays > 0) {
+            throw (std::invalid_argument(
+                "sql::PreparedStatement: cannot mix arrays and single values."
+                ));
         }
+        if (mySlots.size() < myNext) {
+            mySlots.resize(myNext);
+        }
+        myCount = std::max(myCount, myNext);
+        Slot& slot = mySlots[myNext-1];
+        slot.direction = SQL_PARAM_INPUT;
+        slot.target = 0, slot.receive = 0, slot.reported.reset();
+        return (slot);
+    }
+
+    char * PreparedStatement::reserve (Slot& slot, std::size_t size)
+    {
+            // Keep the slot's region when the value fits, so that later
+            // executions only overwrite the data.
+        size = std::max<std::size_t>(size, 1);
+        if (size > slot.capacity)
+        {
+            const std::size_t alignment = 16;
+            slot.offset = (myArena.size()+alignment-1) / alignment*alignment;
+            slot.capacity = std::max(size, 2*slot.capacity);
+            myArena.resize(slot.offset+slot.capacity);
+        }
+        slot.data = 0;
+        return (&myArena[slot.offset]);
+    }
+
+    PreparedStatement::Slot& PreparedStatement::store (
+        ::SQLSMALLINT type, ::SQLSMALLINT sql_type, ::SQLULEN size,
+        const void * data, std::size_t width)
+    {
+        Slot& slot = next_slot();
+        std::memcpy(reserve(slot, width), data, width);
+        slot.type = type, slot.sql_type = sql_type;
+        slot.size = size, slot.digits = 0;
+        slot.width = width, slot.length = width, slot.indicator = 0;
+        return (slot);
+    }
+
+    PreparedStatement& PreparedStatement::bind_value (
+        ::SQLSMALLINT type, ::SQLSMALLINT sql_type, ::SQLULEN size,
+        const void * data, std::size_t width)
+    {
+        store(type, sql_type, size, data, width);
         ++myNext; return (*this);
     }
 
+    PreparedStatement::Slot& PreparedStatement::next_array (
+        ::SQLSMALLINT type, ::SQLSMALLINT sql_type, ::SQLULEN size,
+        ::SQLLEN width, std::size_t count)
+    {
+        if (count == 0) {
+            throw (std::invalid_argument(
+                "sql::PreparedStatement: empty parameter array."
+                ));
+        }
+        if (myArrays == 0) {
+            myArraySize = count;
+        }
+        if ((count != myArraySize) || (myArrays != myNext-1)) {
+            throw (std::invalid_argument(
+                "sql::PreparedStatement: parameter arrays must all have the"
+                " same length."
+                ));
+        }
+        if (mySlots.size() < myNext) {
+            mySlots.resize(myNext);
+        }
+        myCount = std::max(myCount, myNext);
+        Slot& slot = mySlots[myNext-1];
+        slot.direction = SQL_PARAM_INPUT;
+        slot.type = type, slot.sql_type = sql_type;
+        slot.size = size, slot.digits = 0;
+        slot.width = width, slot.indicator = 0;
+        slot.lengths.clear();
+        slot.target = 0, slot.receive = 0, slot.reported.reset();
+        ++myArrays;
+        ++myNext; return (slot);
+    }
+
+    PreparedStatement& PreparedStatement::read_outputs ()
+    {
+        const std::size_t count =
+            std::min<std::size_t>(myExecuted, mySlots.size());
+        for (std::size_t i = 0; (i < count); ++i)
+        {
+            const Slot& slot = mySlots[i];
+            if (slot.receive != 0) {
+                (*slot.receive)(slot.target, &myArena[slot.offset],
+                                slot.length, slot.width);
+            }
+            if (slot.reported) {
+                *slot.reported = slot.length;
+            }
+        }
+        return (*this);
+    }
+
+    void PreparedStatement::output
+        (Slot& slot, string& value, size_t capacity)
+    {
+            // Received in the arena, then copied to the caller's string.
+        const std::size_t length = value.length()*sizeof(character);
+        const std::size_t width = (std::max<std::size_t>(
+            capacity, value.length())+1)*sizeof(character);
+        char *const data = reserve(slot, width);
+        std::memset(data, 0, width);
+        std::memcpy(data, value.data(), length);
+        slot.size = width/sizeof(character)-1, slot.width = width;
+        slot.target = &value, slot.receive = &::receive_string<character>;
+    }
+
+    void PreparedStatement::output
+        (Slot& slot, wstring& value, size_t capacity)
+    {
+        const std::size_t length = value.length()*sizeof(wcharacter);
+        const std::size_t width = (std::max<std::size_t>(
+            capacity, value.length())+1)*sizeof(wcharacter);
+        char *const data = reserve(slot, width);
+        std::memset(data, 0, width);
+        std::memcpy(data, value.data(), length);
+        slot.size = width/sizeof(wcharacter)-1, slot.width = width;
+        slot.target = &value, slot.receive = &::receive_string<wcharacter>;
+    }
+
+    void PreparedStatement::output (Slot& slot, Date& value, size_t)
+    {
+        slot.data = &value.value();
+    }
+
+    void PreparedStatement::output (Slot& slot, Guid& value, size_t)
+    {
+        slot.data = &value.value();
+    }
+
+    void PreparedStatement::output (Slot& slot, Numeric& value, size_t)
+    {
+        slot.data = &value.value();
+    }
+
+    void PreparedStatement::output (Slot& slot, Time& value, size_t)
+    {
+        slot.data = &value.value();
+    }
+
+    void PreparedStatement::output (Slot& slot, Timestamp& value, size_t)
+    {
+        slot.data = &value.value();
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<int8>& values)
+    {
+            // Sent straight from the caller's vector.
+        next_array(SQL_C_STINYINT, SQL_TINYINT, 0, sizeof(int8), values.size())
+            .data = values.data();
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<uint8>& values)
+    {
+            // Sent straight from the caller's vector.
+        next_array(SQL_C_UTINYINT, SQL_TINYINT, 0, sizeof(uint8), values.size())
+            .data = values.data();
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<int16>& values)
+    {
+            // Sent straight from the caller's vector.
+        next_array(SQL_C_SSHORT, SQL_SMALLINT, 0, sizeof(int16), values.size())
+            .data = values.data();
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<uint16>& values)
+    {
+            // Sent straight from the caller's vector.
+        next_array(SQL_C_USHORT, SQL_SMALLINT, 0, sizeof(uint16), values.size())
+            .data = values.data();
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<int32>& values)
+    {
+            // Sent straight from the caller's vector.
+        next_array(SQL_C_SLONG, SQL_INTEGER, 0, sizeof(int32), values.size())
+            .data = values.data();
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<uint32>& values)
+    {
+            // Sent straight from the caller's vector.
+        next_array(SQL_C_ULONG, SQL_INTEGER, 0, sizeof(uint32), values.size())
+            .data = values.data();
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<int64>& values)
+    {
+            // Sent straight from the caller's vector.
+        next_array(SQL_C_SBIGINT, SQL_BIGINT, 0, sizeof(int64), values.size())
+            .data = values.data();
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<uint64>& values)
+    {
+            // Sent straight from the caller's vector.
+        next_array(SQL_C_UBIGINT, SQL_BIGINT, 0, sizeof(uint64), values.size())
+            .data = values.data();
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<float>& values)
+    {
+            // Sent straight from the caller's vector.
+        next_array(SQL_C_FLOAT, SQL_REAL, 0, sizeof(float), values.size())
+            .data = values.data();
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<double>& values)
+    {
+            // Sent straight from the caller's vector.
+        next_array(SQL_C_DOUBLE, SQL_DOUBLE, 0, sizeof(double), values.size())
+            .data = values.data();
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<string>& values)
+    {
+        ::SQLLEN width = sizeof(character);
+        for (std::size_t i = 0; (i < values.size()); ++i) {
+            width = std::max(width,
+                ::SQLLEN((values[i].length()+1)*sizeof(character)));
+        }
+        Slot& slot = next_array(SQL_C_CHAR, SQL_VARCHAR,
+                                width/sizeof(character)-1,
+                                width, values.size());
+        ::copy_strings(values, width, reserve(slot, values.size()*width),
+                       slot.lengths);
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<wstring>& values)
+    {
+        ::SQLLEN width = sizeof(wcharacter);
+        for (std::size_t i = 0; (i < values.size()); ++i) {
+            width = std::max(width,
+                ::SQLLEN((values[i].length()+1)*sizeof(wcharacter)));
+        }
+        Slot& slot = next_array(SQL_C_WCHAR, SQL_WVARCHAR,
+                                width/sizeof(wcharacter)-1,
+                                width, values.size());
+        ::copy_strings(values, width, reserve(slot, values.size()*width),
+                       slot.lengths);
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<Date>& values)
+    {
+        Slot& slot = next_array(SQL_C_TYPE_DATE, SQL_TYPE_DATE, SQL_DATE_LEN,
+                                sizeof(Date::Value), values.size());
+        ::copy_values(values, reserve(slot, values.size()*slot.width));
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<Guid>& values)
+    {
+        Slot& slot = next_array(SQL_C_GUID, SQL_GUID, sizeof(::SQLGUID),
+                                sizeof(Guid::Value), values.size());
+        ::copy_values(values, reserve(slot, values.size()*slot.width));
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<Numeric>& values)
+    {
+        Slot& slot = next_array(SQL_C_NUMERIC, SQL_NUMERIC,
+                                sizeof(::SQL_NUMERIC_STRUCT),
+                                sizeof(Numeric::Value), values.size());
+        ::copy_values(values, reserve(slot, values.size()*slot.width));
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<Time>& values)
+    {
+        Slot& slot = next_array(SQL_C_TYPE_TIME, SQL_TYPE_TIME, SQL_TIME_LEN,
+                                sizeof(Time::Value), values.size());
+        ::copy_values(values, reserve(slot, values.size()*slot.width));
+        return (*this);
+    }
+
+    PreparedStatement& PreparedStatement::bind
+        (const std::vector<Timestamp>& values)
+    {
+        Slot& slot = next_array(SQL_C_TYPE_TIMESTAMP, SQL_TYPE_TIMESTAMP,
+                                sizeof(::SQL_TIMESTAMP_STRUCT),
+                                sizeof(Timestamp::Value), values.size());
+        ::copy_values(values, reserve(slot, values.size()*slot.width));
+        return (*this);
+    }
+
+    size_t PreparedStatement::rows_processed () const
+    {
+        return (myProcessed);
+    }
+
+    uint16 PreparedStatement::row_status (size_t row) const
+    {
+        return (myStatus[row]);
+    }
+
+    bool PreparedStatement::row_succeeded (size_t row) const
+    {
+        return ((myStatus[row] == SQL_PARAM_SUCCESS) ||
+                (myStatus[row] == SQL_PARAM_SUCCESS_WITH_INFO));
+    }
+
     PreparedStatement& operator>> (PreparedStatement& statement,
                                    Parameter& parameter)
     {
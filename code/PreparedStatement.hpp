@@ -30,12 +30,20 @@
 #include "__configure__.hpp"
 #include "types.hpp"
 #include "string.hpp"
+#include "Bytes.hpp"
 #include "Date.hpp"
 #include "Guid.hpp"
 #include "Numeric.hpp"
+#include "Output.hpp"
 #include "Statement.hpp"
+#include "Stream.hpp"
 #include "Time.hpp"
 #include "Timestamp.hpp"
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace sql {
 
@@ -44,6 +52,14 @@ namespace sql {
 
         /*!
          * @brief Fast, safe and convenient way to write queries.
+         *
+         * Bound values are copied into a buffer owned by the statement, so
+         * they need not outlive the call to @c bind().  Each parameter keeps
+         * its place in that buffer across executions, so repeated
+         * executions only overwrite the values.  @c Bytes and arrays of
+         * numbers are the exception: they are sent straight from the
+         * caller's memory.  @c Stream values are not buffered at all: they
+         * are sent in chunks while the statement executes.
          */
     class PreparedStatement :
         public Statement
@@ -55,9 +71,104 @@ namespace sql {
              */
         typedef PreparedStatement&(*Manipulator)(PreparedStatement&);
 
+    private:
+        struct Binding
+        {
+            ::SQLSMALLINT direction;
+            ::SQLSMALLINT type;
+            ::SQLSMALLINT sql_type;
+            ::SQLULEN size;
+            ::SQLSMALLINT digits;
+            ::SQLPOINTER data;
+            ::SQLLEN width;
+            ::SQLLEN * indicator;
+
+            bool operator== (const Binding& other) const
+            {
+                return ((direction == other.direction)
+                    && (type == other.type) && (sql_type == other.sql_type)
+                    && (size == other.size) && (digits == other.digits)
+                    && (data == other.data) && (width == other.width)
+                    && (indicator == other.indicator));
+            }
+        };
+
+        struct Slot
+        {
+            ::SQLSMALLINT direction;
+            ::SQLSMALLINT type;
+            ::SQLSMALLINT sql_type;
+            ::SQLULEN size;
+            ::SQLSMALLINT digits;
+            ::SQLLEN width;
+
+                // Caller's memory, or 0 for data in the arena.
+            const void * data;
+            std::size_t offset;
+            std::size_t capacity;
+
+                // Caller's indicator, or 0 for the one(s) below.
+            ::SQLLEN * indicator;
+            ::SQLLEN length;
+            std::vector< ::SQLLEN > lengths;
+
+                // Copies an output value from the arena to the caller's
+                // variable, if needed.
+            void * target;
+            void (*receive)(void*, const char*, ::SQLLEN, ::SQLLEN);
+
+                // Caller-visible copy of an output value's indicator.
+            std::shared_ptr< ::SQLLEN > reported;
+
+                // Last call to ::SQLBindParameter(), if any.
+            bool bound;
+            Binding binding;
+
+            Slot ()
+                : direction(SQL_PARAM_INPUT)
+                , type(0), sql_type(0), size(0), digits(0), width(0)
+                , data(0), offset(0), capacity(0)
+                , indicator(0), length(0), lengths()
+                , target(0), receive(0), reported()
+                , bound(false), binding()
+            {}
+        };
+
+        struct Name
+        {
+            std::string name;
+            std::vector<uint16> ordinals;
+        };
+
         /* data. */
     private:
         uint16 myNext;
+        uint16 myCount;
+        mutable int16 myParameters;
+
+            // Parameters sent by the last execution.
+        uint16 myExecuted;
+
+            // Named placeholders, sorted by name.
+        std::vector<Name> myNames;
+
+            // Bound values are copied into the arena and bound to the
+            // driver when the statement is executed.
+        std::vector<char> myArena;
+        std::deque<Slot> mySlots;
+
+            // Parameter arrays (bulk execution).
+        ::SQLULEN myArraySize;
+        uint16 myArrays;
+        ::SQLULEN myParamsetSize;
+        ::SQLULEN myProcessed;
+        std::vector< ::SQLUSMALLINT > myStatus;
+
+            // Values supplied at execution, and a chunk of one.  The copies
+            // outlive the caller's wrappers: their address is the token the
+            // driver hands back.
+        std::deque<Stream> myStreams;
+        std::vector<char> myChunk;
 
         /* construction. */
     public:
@@ -65,9 +176,27 @@ namespace sql {
          * @brief Prepare an SQL statement.
          * @param connection Connection over which to execute the statement.
          * @param text SQL statement (query/update) text.
+         *
+         * Besides positional @c ? placeholders, the text may contain named
+         * placeholders, written @c :name or @c \@name.  They are replaced
+         * by @c ? before the statement is prepared and are bound using
+         * @c bind(const char*,const Value&).  A name may appear several
+         * times; binding it sets all occurrences.
+         *
+         * @c \@name is left alone when the text also uses @c ? markers,
+         * @c declare or @c set @c \@, since it then most likely refers to
+         * a variable.  @c \@\@name is never replaced.
+         *
+         * @see positional()
          */
         PreparedStatement (Connection& connection, const string& text);
 
+        /*!
+         * @brief Restore bulk execution settings before the statement
+         *  handle is reused.
+         */
+        virtual ~PreparedStatement ();
+
         /* methods. */
     public:
         /*!
@@ -75,7 +204,8 @@ namespace sql {
          * @return The number of placeholder parameters in the query.
          *
          * The @c bind() function must be called repeatedly to fill in each
-         * parameter.
+         * parameter.  The count is obtained from the driver once, then
+         * cached.
          */
         int16 parameter_count () const;
 
@@ -108,6 +238,38 @@ namespace sql {
              */
         PreparedStatement& reset ();
 
+            /*!
+             * @brief Binds a value to all occurrences of a named parameter.
+             * @param name Placeholder name, without the leading @c : or @c \@.
+             * @param value Any value that can be bound by position.
+             * @return @c *this, for method chaining.
+             *
+             * Arrays can only be bound by position.
+             */
+        template<typename Value>
+        PreparedStatement& bind (const char * name, const Value& value)
+        {
+            const std::vector<uint16>& ordinals = parameter(name);
+            const uint16 next = myNext;
+            for (std::size_t i = 0; (i < ordinals.size()); ++i) {
+                myNext = ordinals[i], bind(value);
+            }
+            myNext = next; return (*this);
+        }
+
+            /*!
+             * @brief Replace named placeholders by @c ?, as done before
+             *  preparing a statement.
+             * @param text SQL statement text.
+             * @return The text passed to the driver.
+             */
+        static std::string positional (const std::string& text);
+
+            /*!
+             * @brief Check if the statement has a named parameter.
+             */
+        bool has_parameter (const char * name) const;
+
             /*!
              * @brief Binds a parameter as null (no value).
              */
@@ -173,6 +335,62 @@ namespace sql {
              */
         PreparedStatement& bind (const wstring& value);
 
+            /*!
+             * @brief Binds a binary value to the next parameter.
+             *
+             * The bytes are sent straight from the caller's buffer, which
+             * must remain valid until the statement is executed.
+             */
+        PreparedStatement& bind (const Bytes& value);
+
+            /*!
+             * @brief Binds a value supplied at execution to the next
+             *  parameter.
+             *
+             * The value is read from @a value's source and sent in chunks
+             * when the statement is executed.  The source (not the @c Stream
+             * wrapper) must remain valid until then.
+             */
+        PreparedStatement& bind (const Stream& value);
+
+            /*!
+             * @brief Binds an output (or input/output) parameter to the
+             *  next parameter.
+             *
+             * The value is written to the caller's variable when the
+             * statement is executed.  The variable must remain valid until
+             * then, but the @c Output wrapper need not.
+             *
+             * @see read_outputs()
+             */
+        template<typename T>
+        PreparedStatement& bind (const Output<T>& value)
+        {
+                // Bind the input value as usual, then redirect the slot.
+            bind(value.value());
+            Slot& slot = mySlots[myNext-2];
+            output(slot, value.value(), value.capacity());
+            slot.direction = value.input()?
+                SQL_PARAM_INPUT_OUTPUT : SQL_PARAM_OUTPUT;
+            slot.indicator = 0, slot.reported = value.indicator();
+            if (!value.input()) {
+                slot.length = SQL_NULL_DATA;
+            }
+            *slot.reported = slot.length;
+            return (*this);
+        }
+
+            /*!
+             * @brief Copy output string parameters to the caller's variables,
+             *  and null indicators to the @c Output objects.
+             *
+             * This is done when the statement is executed.  However, some
+             * drivers only return output values once all result sets have
+             * been read: call this again at that point.  Other types are
+             * written to the caller's variables directly by the driver.
+             */
+        PreparedStatement& read_outputs ();
+
             /*!
              * @brief Binds a date value to the next parameter.
              */
@@ -198,6 +416,120 @@ namespace sql {
              */
         PreparedStatement& bind (const Timestamp& timestamp);
 
+        /*
+         * Bulk execution: when parameters are bound to arrays, execute()
+         * runs the statement once per row in a single driver call.  All
+         * parameters must then be bound to arrays of the same length.
+         * Arrays of numbers are sent straight from the caller's memory,
+         * which must remain valid until execution; other values are copied.
+         * Use rows_processed() and row_status() to check each row.
+         */
+
+            /*!
+             * @brief Binds one signed 8-bit integer per row.
+             */
+        PreparedStatement& bind (const std::vector<int8>& values);
+
+            /*!
+             * @brief Binds one unsigned 8-bit integer per row.
+             */
+        PreparedStatement& bind (const std::vector<uint8>& values);
+
+            /*!
+             * @brief Binds one signed 16-bit integer per row.
+             */
+        PreparedStatement& bind (const std::vector<int16>& values);
+
+            /*!
+             * @brief Binds one unsigned 16-bit integer per row.
+             */
+        PreparedStatement& bind (const std::vector<uint16>& values);
+
+            /*!
+             * @brief Binds one signed 32-bit integer per row.
+             */
+        PreparedStatement& bind (const std::vector<int32>& values);
+
+            /*!
+             * @brief Binds one unsigned 32-bit integer per row.
+             */
+        PreparedStatement& bind (const std::vector<uint32>& values);
+
+            /*!
+             * @brief Binds one signed 64-bit integer per row.
+             */
+        PreparedStatement& bind (const std::vector<int64>& values);
+
+            /*!
+             * @brief Binds one unsigned 64-bit integer per row.
+             */
+        PreparedStatement& bind (const std::vector<uint64>& values);
+
+            /*!
+             * @brief Binds one 32-bit floating point per row.
+             */
+        PreparedStatement& bind (const std::vector<float>& values);
+
+            /*!
+             * @brief Binds one 64-bit floating point per row.
+             */
+        PreparedStatement& bind (const std::vector<double>& values);
+
+            /*!
+             * @brief Binds one string per row.
+             */
+        PreparedStatement& bind (const std::vector<string>& values);
+
+            /*!
+             * @brief Binds one wide string per row.
+             */
+        PreparedStatement& bind (const std::vector<wstring>& values);
+
+            /*!
+             * @brief Binds one date value per row.
+             */
+        PreparedStatement& bind (const std::vector<Date>& values);
+
+            /*!
+             * @brief Binds one unique identifier value per row.
+             */
+        PreparedStatement& bind (const std::vector<Guid>& values);
+
+            /*!
+             * @brief Binds one numeric value per row.
+             */
+        PreparedStatement& bind (const std::vector<Numeric>& values);
+
+            /*!
+             * @brief Binds one time value per row.
+             */
+        PreparedStatement& bind (const std::vector<Time>& values);
+
+            /*!
+             * @brief Binds one timestamp value per row.
+             */
+        PreparedStatement& bind (const std::vector<Timestamp>& values);
+
+            /*!
+             * @brief Number of rows processed by the last bulk execution.
+             *
+             * @see bind(const std::vector<int32>&)
+             */
+        size_t rows_processed () const;
+
+            /*!
+             * @brief Status of a row in the last bulk execution.
+             * @param row Zero-based row index, less than @c rows_processed().
+             * @return One of the @c SQL_PARAM_* status codes.
+             */
+        uint16 row_status (size_t row) const;
+
+            /*!
+             * @brief Check if a row of the last bulk execution succeeded.
+             * @param row Zero-based row index, less than @c rows_processed().
+             */
+        bool row_succeeded (size_t row) const;
+
             /*!
              * @brief Applies a manipulator to the update object.
              */
@@ -205,6 +537,33 @@ namespace sql {
             return ((*manipulator)(*this));
         }
 
+    private:
+        const std::vector<uint16>& parameter (const char * name) const;
+        Slot& next_slot ();
+        char * reserve (Slot& slot, std::size_t size);
+        Slot& store (
+            ::SQLSMALLINT type, ::SQLSMALLINT sql_type, ::SQLULEN size,
+            const void * data, std::size_t width);
+        PreparedStatement& bind_value (
+            ::SQLSMALLINT type, ::SQLSMALLINT sql_type, ::SQLULEN size,
+            const void * data, std::size_t width);
+        Slot& next_array (
+            ::SQLSMALLINT type, ::SQLSMALLINT sql_type, ::SQLULEN size,
+            ::SQLLEN width, std::size_t count);
+
+        template<typename T>
+        void output (Slot& slot, T& value, size_t)
+        {
+            slot.data = &value;
+        }
+        void output (Slot& slot, string& value, size_t capacity);
+        void output (Slot& slot, wstring& value, size_t capacity);
+        void output (Slot& slot, Date& value, size_t);
+        void output (Slot& slot, Guid& value, size_t);
+        void output (Slot& slot, Numeric& value, size_t);
+        void output (Slot& slot, Time& value, size_t);
+        void output (Slot& slot, Timestamp& value, size_t);
+
         /* overrides. */
     public:
             /*!
@@ -212,6 +571,11 @@ namespace sql {
              */
         virtual PreparedStatement& execute ();
 
+    protected:
+        virtual void put_data (::SQLPOINTER token);
+        virtual void before_execute ();
+        virtual void after_execute ();
+
         /* operators. */
     public:
         friend PreparedStatement& operator>> (PreparedStatement& statement,
@@ -250,6 +614,37 @@ namespace sql {
      */
     PreparedStatement& execute (PreparedStatement& statement);
 
+    /*!
+     * @brief Bind one value per parameter, then send the query.
+     * @param statement Prepared statement.
+     * @param args Parameter values, in order.
+     * @return @a statement, for method chaining.
+     * @throw std::invalid_argument The number of values does not match the
+     *  number of parameters.
+     *
+     * The calls to @c bind() are unrolled at compile time, so each value
+     * goes straight to its overload and the driver sees the whole set of
+     * parameters at once, when the statement is executed.
+     *
+     * @code
+     *  sql::execute(statement, sql::int32(1), sql::string("one"));
+     * @endcode
+     */
+    template<typename Arg, typename... Args>
+    PreparedStatement& execute (PreparedStatement& statement,
+                                const Arg& arg, const Args&... args)
+    {
+        if (statement.parameter_count() != int16(1+sizeof...(Args))) {
+            throw (std::invalid_argument(
+                "sql::execute(): wrong number of parameter values."
+                ));
+        }
+        statement.reset().bind(arg);
+        const int unroll[] = { 0, (statement.bind(args), 0)... };
+        (void)unroll;
+        return (statement.execute());
+    }
+
     /*!
      * @brief Run-time type information for prepared statement parameters.
      */
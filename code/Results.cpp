@@ -27,8 +27,65 @@
 #include "Results.hpp"
 #include "Diagnostic.hpp"
 
+#include <cstring>
 #include <iostream>
 
+namespace {
+
+    // Widest character column that is bound to a buffer, in characters.
+    // Wider columns (e.g. long text) are always read using ::SQLGetData().
+    const ::SQLULEN max_bound_width = 4096;
+
+    // Room reserved before reading a character column, so that typical
+    // values are read with a single call.
+    const sql::size_t initial_string_capacity = 255;
+
+    // Read a character column straight into the string's buffer.  The
+    // length reported by the first call is used to size the buffer for the
+    // rest of the value in one step.  If the driver cannot report it, the
+    // buffer is grown geometrically.
+    template<typename Char>
+    ::SQLRETURN get_string (::SQLHSTMT statement, ::SQLUSMALLINT column,
+                            ::SQLSMALLINT type, sql::basic_string<Char>& value)
+    {
+        typedef typename sql::basic_string<Char>::size_type size_type;
+        const ::SQLLEN unit = sizeof(Char);
+
+        value.clear();
+        value.reserve(initial_string_capacity);
+        size_type offset = 0;
+        ::SQLRETURN result = SQL_SUCCESS;
+        while (true)
+        {
+            const size_type room = value.capacity()-offset;
+            ::SQLLEN length = 0;
+            result = ::SQLGetData(
+                statement, column, type, value.data()+offset,
+                (room+1)*unit, &length
+                );
+            if (result == SQL_NO_DATA) {
+                result = SQL_SUCCESS; break;
+            }
+            if (result != SQL_SUCCESS_WITH_INFO) {
+                if (length == SQL_NULL_DATA) {
+                    value.clear();
+                }
+                break;
+            }
+            if ((length != SQL_NO_TOTAL) && (length/unit <= room)) {
+                result = SQL_SUCCESS; break;
+            }
+
+                // Truncated: the buffer is full and null terminated.
+            offset += room;
+            value.reserve((length == SQL_NO_TOTAL)?
+                          2*value.capacity() : offset+(length/unit-room));
+        }
+        return (result);
+    }
+
+}
+
 namespace sql {
 
     const Results::State Results::State::good ()
@@ -96,16 +153,31 @@ namespace sql {
         return (State(myBits | other.myBits));
     }
 
+    Results::~Results ()
+    {
+        unbind();
+    }
+
     size_t Results::rows () const
     {
-        ::SQLLEN count = 0;
-        const ::SQLRETURN result = ::SQLRowCount(
-            myStatement.handle().value(), &count
-            );
-        if (result != SQL_SUCCESS) {
-            throw (Diagnostic(myStatement.handle()));
+        return (myStatement.rows());
+    }
+
+    bool Results::next_result_set ()
+    {
+            // Bindings and learned types belong to the current result set.
+        unbind();
+        myColumns.clear();
+        myColumn = 0;
+        myFetched = 0;
+        myRow = 0;
+        myLearning = true;
+        myState = State();
+        if (!myStatement.next_result_set()) {
+            myState.set(State::fail());
+            return (false);
         }
-        return (count);
+        return (true);
     }
 
     Results& Results::skip ()
@@ -118,173 +190,265 @@ namespace sql {
         return (*this);
     }
 
-    Results& Results::operator>> (const Row&)
+    Results& Results::fetch_size (size_t rows)
     {
-        if (!myState) {
-            return (*this);
+        const ::SQLULEN size = (rows > 1)? rows : 1;
+        if (size != myFetchSize) {
+            myFetchSize = size, myLearning = true;
         }
+        return (*this);
+    }
 
-        const ::SQLRETURN result = ::SQLFetch(myStatement.handle().value());
-        if (result != SQL_SUCCESS) {
-            myState.set(State::fail());
-        }
-        myColumn = 1;
+    Results& Results::bind_strings (bool enable)
+    {
+        myStrings = enable;
         return (*this);
     }
 
-    Results& Results::operator>> (const Null&)
+    void Results::learn (::SQLSMALLINT type, ::SQLLEN width)
     {
-        if (!myState) {
-            return (*this);
+        if (!myLearning || (myBinding > 0)) {
+            return;
+        }
+        if (myColumns.size() < myColumn) {
+            myColumns.resize(myColumn);
+        }
+        Column& column = myColumns[myColumn-1];
+        if (column.type == type) {
+            return;
         }
 
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_CHAR, 0, 0, &length
-            );
-        if (result != SQL_SUCCESS) {
-            myState.set(State::fail());
+            // Character data is bound using the column's declared size, but
+            // only on request.
+        if (((type == SQL_C_CHAR) || (type == SQL_C_WCHAR)) && !myStrings) {
+            width = 0;
+        }
+        else if ((type == SQL_C_CHAR) || (type == SQL_C_WCHAR))
+        {
+            const std::vector<ColumnInfo>& columns = myStatement.columns();
+            const ::SQLULEN size = (myColumn <= columns.size())?
+                columns[myColumn-1].size() : 0;
+            const ::SQLLEN unit = (type == SQL_C_CHAR)?
+                sizeof(character) : sizeof(wcharacter);
+            width = ((size > 0) && (size <= ::max_bound_width))?
+                (size+1)*unit : 0;
+        }
+        column.type = type;
+        column.width = width;
+    }
+
+    bool Results::bind ()
+    {
+            // Bind columns up to the first one that cannot be bound.  Drivers
+            // allow ::SQLGetData() on unbound columns after the last bound one.
+        std::size_t count = 0;
+        while ((count < myColumns.size()) &&
+               ((myColumns[count].type == SQL_UNKNOWN_TYPE) ||
+                (myColumns[count].width > 0)))
+        {
+            ++count;
+        }
+        while ((count > 0) && (myColumns[count-1].type == SQL_UNKNOWN_TYPE)) {
+            --count;
+        }
+        if (count == 0) {
+            return (false);
         }
-        ++myColumn;
-        return (*this);
-    }
 
-    Results& Results::operator>> (int8& value)
-    {
-        if (!myState) {
-            return (*this);
+            // Rows can only be fetched in blocks if all columns are bound.
+        ::SQLULEN rows = myFetchSize;
+        for (std::size_t i = count; (i < myColumns.size()); ++i)
+        {
+            if (myColumns[i].type != SQL_UNKNOWN_TYPE) {
+                rows = 1;
+            }
         }
 
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_STINYINT,
-            &value, sizeof(value), &length
+        for (std::size_t i = 0; (i < count); ++i)
+        {
+            Column& column = myColumns[i];
+            if (column.type == SQL_UNKNOWN_TYPE) {
+                continue;
+            }
+            column.data.resize(rows*column.width);
+            column.lengths.resize(rows);
+            const ::SQLRETURN result = ::SQLBindCol(
+                handle().value(), static_cast< ::SQLUSMALLINT >(i+1),
+                column.type, &column.data[0], column.width, &column.lengths[0]
+                );
+            if (result != SQL_SUCCESS) {
+                const Diagnostic diagnostic(handle());
+                myBinding = rows, unbind();
+                throw (diagnostic);
+            }
+        }
+        myBinding = rows;
+        myBound = static_cast< ::SQLUSMALLINT >(count);
+        if (rows == 1) {
+            return (true);
+        }
+
+        ::SQLRETURN result = ::SQLSetStmtAttr(
+            handle().value(), SQL_ATTR_ROW_ARRAY_SIZE,
+            reinterpret_cast< ::SQLPOINTER >(rows), 0
             );
+        if (result == SQL_SUCCESS) {
+            result = ::SQLSetStmtAttr(
+                handle().value(), SQL_ATTR_ROWS_FETCHED_PTR, &myFetched, 0
+                );
+        }
         if (result != SQL_SUCCESS) {
-            myState.set(State::fail());
+            const Diagnostic diagnostic(handle());
+            unbind();
+            throw (diagnostic);
         }
-        ++myColumn;
-        return (*this);
+        return (true);
     }
 
-    Results& Results::operator>> (uint8& value)
+    void Results::unbind () throw()
     {
-        if (!myState) {
-            return (*this);
+        if (myBinding == 0) {
+            return;
         }
-
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_UTINYINT,
-            &value, sizeof(value), &length
-            );
-        if (result != SQL_SUCCESS) {
-            myState.set(State::fail());
+        ::SQLFreeStmt(handle().value(), SQL_UNBIND);
+        if (myBinding > 1)
+        {
+            ::SQLSetStmtAttr(
+                handle().value(), SQL_ATTR_ROW_ARRAY_SIZE,
+                reinterpret_cast< ::SQLPOINTER >(::SQLULEN(1)), 0
+                );
+            ::SQLSetStmtAttr(
+                handle().value(), SQL_ATTR_ROWS_FETCHED_PTR, 0, 0
+                );
         }
-        ++myColumn;
-        return (*this);
+        myBinding = 0;
+        myBound = 0;
     }
 
-    Results& Results::operator>> (int16& value)
+    void Results::release () throw()
     {
-        if (!myState) {
-            return (*this);
-        }
+        unbind();
+        myColumns.clear();
+        myLearning = false;
+    }
 
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_SSHORT,
-            &value, sizeof(value), &length
-            );
-        if (result != SQL_SUCCESS) {
-            myState.set(State::fail());
+    const Results::Column * Results::bound (::SQLSMALLINT type) const
+    {
+        if ((myBinding == 0) || (myColumn > myColumns.size())) {
+            return (0);
         }
-        ++myColumn;
-        return (*this);
+        const Column& column = myColumns[myColumn-1];
+        return ((column.type == type)? &column : 0);
     }
 
-    Results& Results::operator>> (uint16& value)
+    template<typename Char>
+    bool Results::reread (::SQLSMALLINT type, basic_string<Char>& value)
     {
-        if (!myState) {
-            return (*this);
+        if (myBinding > 1)
+        {
+                // The other rows of the block are still needed.
+            const ::SQLRETURN result = ::SQLSetPos(
+                handle().value(), static_cast< ::SQLSETPOSIROW >(myRow+1),
+                SQL_POSITION, SQL_LOCK_NO_CHANGE
+                );
+            if (result != SQL_SUCCESS) {
+                return (false);
+            }
         }
-
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_USHORT,
-            &value, sizeof(value), &length
-            );
-        if (result != SQL_SUCCESS) {
-            myState.set(State::fail());
+        else {
+            release();
         }
-        ++myColumn;
-        return (*this);
+        const ::SQLRETURN result = ::get_string(
+            handle().value(), myColumn, type, value
+            );
+        return (result == SQL_SUCCESS);
     }
 
-    Results& Results::operator>> (int32& value)
+    Results& Results::get (::SQLSMALLINT type, ::SQLPOINTER data, ::SQLLEN size)
     {
         if (!myState) {
             return (*this);
         }
 
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_SLONG,
-            &value, sizeof(value), &length
-            );
-        if (result != SQL_SUCCESS) {
+        if (const Column *const column = bound(type))
+        {
+                // Leave the value untouched on null, like ::SQLGetData().
+            if (column->lengths[myRow] != SQL_NULL_DATA) {
+                std::memcpy(data, &column->data[myRow*column->width], size);
+            }
+        }
+        else if (myBinding > 1)
+        {
+                // Rows in a block cannot be read using ::SQLGetData().
             myState.set(State::fail());
         }
+        else
+        {
+            if (myColumn <= myBound) {
+                release();
+            }
+            learn(type, size);
+            ::SQLLEN length = 0;
+            const ::SQLRETURN result = ::SQLGetData(
+                myStatement.handle().value(), myColumn, type,
+                data, size, &length
+                );
+            if (result != SQL_SUCCESS) {
+                myState.set(State::fail());
+            }
+        }
         ++myColumn;
         return (*this);
     }
 
-    Results& Results::operator>> (uint32& value)
+    Results& Results::operator>> (const Row&)
     {
         if (!myState) {
             return (*this);
         }
+        myColumn = 1;
 
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_ULONG,
-            &value, sizeof(value), &length
-            );
-        if (result != SQL_SUCCESS) {
-            myState.set(State::fail());
+            // Move to the next row in the current block, if any.
+        if (++myRow < myFetched) {
+            return (*this);
         }
-        ++myColumn;
-        return (*this);
-    }
 
-    Results& Results::operator>> (int64& value)
-    {
-        if (!myState) {
-            return (*this);
+            // Bind columns using the types read in the first row.
+        if ((myFetched > 0) && myLearning)
+        {
+            unbind();
+            bind();
+            myLearning = false;
         }
 
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_SBIGINT,
-            &value, sizeof(value), &length
-            );
-        if (result != SQL_SUCCESS) {
+        myRow = 0;
+        myFetched = 0;
+        const ::SQLRETURN result = ::SQLFetch(myStatement.handle().value());
+        if (myBinding <= 1) {
+            myFetched = (result == SQL_SUCCESS)? 1 : 0;
+        }
+        if ((result != SQL_SUCCESS) &&
+            ((result != SQL_SUCCESS_WITH_INFO) || (myBinding == 0)))
+        {
             myState.set(State::fail());
         }
-        ++myColumn;
         return (*this);
     }
 
-    Results& Results::operator>> (uint64& value)
+    Results& Results::operator>> (const Null&)
     {
         if (!myState) {
             return (*this);
         }
 
+            // Bound and skipped columns are not read using ::SQLGetData().
+        if ((myBinding > 1) || (myColumn <= myBound)) {
+            ++myColumn; return (*this);
+        }
+
         ::SQLLEN length = 0;
         ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_UBIGINT,
-            &value, sizeof(value), &length
+            myStatement.handle().value(), myColumn, SQL_C_CHAR, 0, 0, &length
             );
         if (result != SQL_SUCCESS) {
             myState.set(State::fail());
@@ -293,40 +457,54 @@ namespace sql {
         return (*this);
     }
 
-    Results& Results::operator>> (float& value)
+    Results& Results::operator>> (int8& value)
     {
-        if (!myState) {
-            return (*this);
-        }
+        return (get(SQL_C_STINYINT, &value, sizeof(value)));
+    }
 
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_FLOAT,
-            &value, sizeof(value), &length
-            );
-        if (result != SQL_SUCCESS) {
-            myState.set(State::fail());
-        }
-        ++myColumn;
-        return (*this);
+    Results& Results::operator>> (uint8& value)
+    {
+        return (get(SQL_C_UTINYINT, &value, sizeof(value)));
     }
 
-    Results& Results::operator>> (double& value)
+    Results& Results::operator>> (int16& value)
     {
-        if (!myState) {
-            return (*this);
-        }
+        return (get(SQL_C_SSHORT, &value, sizeof(value)));
+    }
 
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_DOUBLE,
-            &value, sizeof(value), &length
-            );
-        if (result != SQL_SUCCESS) {
-            myState.set(State::fail());
-        }
-        ++myColumn;
-        return (*this);
+    Results& Results::operator>> (uint16& value)
+    {
+        return (get(SQL_C_USHORT, &value, sizeof(value)));
+    }
+
+    Results& Results::operator>> (int32& value)
+    {
+        return (get(SQL_C_SLONG, &value, sizeof(value)));
+    }
+
+    Results& Results::operator>> (uint32& value)
+    {
+        return (get(SQL_C_ULONG, &value, sizeof(value)));
+    }
+
+    Results& Results::operator>> (int64& value)
+    {
+        return (get(SQL_C_SBIGINT, &value, sizeof(value)));
+    }
+
+    Results& Results::operator>> (uint64& value)
+    {
+        return (get(SQL_C_UBIGINT, &value, sizeof(value)));
+    }
+
+    Results& Results::operator>> (float& value)
+    {
+        return (get(SQL_C_FLOAT, &value, sizeof(value)));
+    }
+
+    Results& Results::operator>> (double& value)
+    {
+        return (get(SQL_C_DOUBLE, &value, sizeof(value)));
     }
 
     Results& Results::operator>> (string& value)
@@ -337,19 +515,37 @@ namespace sql {
             return (*this);
         }
 
-        ::SQLRETURN result = SQL_SUCCESS;
-        character buffer[32];
-        do
+        if (const Column *const column = bound(SQL_C_CHAR))
         {
-            ::SQLLEN length = 0;
-            result = ::SQLGetData(
-                myStatement.handle().value(), myColumn, SQL_C_CHAR,
-                buffer, sizeof(buffer), &length
-                );
-            value += buffer;
+            const ::SQLLEN length = column->lengths[myRow];
+            if ((length == SQL_NO_TOTAL) || (length >= column->width))
+            {
+                if (!reread(column->type, value)) {
+                    myState.set(State::fail());
+                }
+            }
+            else if (length != SQL_NULL_DATA) {
+                const character *const first =
+                    reinterpret_cast<const character*>
+                    (&column->data[myRow*column->width]);
+                value.assign(first, first+length);
+            }
+            ++myColumn;
+            return (*this);
+        }
+        if (myBinding > 1) {
+            myState.set(State::fail());
+            ++myColumn;
+            return (*this);
+        }
+        if (myColumn <= myBound) {
+            release();
         }
-        while (result == SQL_SUCCESS_WITH_INFO);
+        learn(SQL_C_CHAR, 0);
 
+        const ::SQLRETURN result = ::get_string(
+            myStatement.handle().value(), myColumn, SQL_C_CHAR, value
+            );
         if (result != SQL_SUCCESS) {
             myState.set(State::fail());
         }
@@ -366,37 +562,36 @@ namespace sql {
             return (*this);
         }
 
-        ::SQLRETURN result = SQL_SUCCESS;
-        wcharacter buffer[32];
-        do
+        if (const Column *const column = bound(SQL_C_WCHAR))
         {
-            ::SQLLEN length = 0;
-            result = ::SQLGetData(
-                myStatement.handle().value(), myColumn, SQL_C_WCHAR, buffer,
-                sizeof(buffer), &length
-                );
-            value += buffer;
+            const ::SQLLEN length = column->lengths[myRow];
+            if ((length == SQL_NO_TOTAL) || (length >= column->width))
+            {
+                if (!reread(column->type, value)) {
+                    myState.set(State::fail());
+                }
+            }
+            else if (length != SQL_NULL_DATA) {
+                const wcharacter *const first =
+                    reinterpret_cast<const wcharacter*>
+                    (&column->data[myRow*column->width]);
+                value.assign(first, first+(length/sizeof(wcharacter)));
+            }
+            ++myColumn;
+            return (*this);
         }
-            // Should check the diagnosis...
-        while (result == SQL_SUCCESS_WITH_INFO);
-
-        if (result != SQL_SUCCESS) {
+        if (myBinding > 1) {
             myState.set(State::fail());
-        }
-        ++myColumn;
-        return (*this);
-    }
-
-    Results& Results::operator>> (Date& date)
-    {
-        if (!myState) {
+            ++myColumn;
             return (*this);
         }
+        if (myColumn <= myBound) {
+            release();
+        }
+        learn(SQL_C_WCHAR, 0);
 
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_TYPE_DATE,
-            &date.value(), sizeof(::SQL_DATE_STRUCT), &length
+        const ::SQLRETURN result = ::get_string(
+            myStatement.handle().value(), myColumn, SQL_C_WCHAR, value
             );
         if (result != SQL_SUCCESS) {
             myState.set(State::fail());
@@ -405,76 +600,63 @@ namespace sql {
         return (*this);
     }
 
-    Results& Results::operator>> (Guid& guid)
+    Results& Results::operator>> (Bytes& value)
     {
         if (!myState) {
             return (*this);
         }
+        if (myBinding > 1) {
+            myState.set(State::fail());
+            ++myColumn;
+            return (*this);
+        }
+        if (myColumn <= myBound) {
+            release();
+        }
+        learn(SQL_C_BINARY, 0);
 
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_GUID, &guid.value(),
-            sizeof(::SQLGUID), &length
+        ::SQLLEN *const length = value.indicator();
+        const ::SQLRETURN result = ::SQLGetData(
+            myStatement.handle().value(), myColumn, SQL_C_BINARY,
+            value.data(), value.capacity(), length
             );
-        if (result != SQL_SUCCESS) {
+        if (result != SQL_SUCCESS)
+        {
+                // Truncated: the buffer holds as much as it can.
+            if (result == SQL_SUCCESS_WITH_INFO) {
+                *length = value.capacity();
+            }
             myState.set(State::fail());
         }
         ++myColumn;
         return (*this);
     }
 
-    Results& Results::operator>> (Numeric& numeric)
+    Results& Results::operator>> (Date& date)
     {
-        if (!myState) {
-            return (*this);
-        }
+        return (get(SQL_C_TYPE_DATE, &date.value(), sizeof(::SQL_DATE_STRUCT)));
+    }
 
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_NUMERIC,
-            &numeric.value(), sizeof(::SQL_NUMERIC_STRUCT), &length
-            );
-        if (result != SQL_SUCCESS) {
-            myState.set(State::fail());
-        }
-        ++myColumn;
-        return (*this);
+    Results& Results::operator>> (Guid& guid)
+    {
+        return (get(SQL_C_GUID, &guid.value(), sizeof(::SQLGUID)));
     }
 
-    Results& Results::operator>> (Time& time)
+    Results& Results::operator>> (Numeric& numeric)
     {
-        if (!myState) {
-            return (*this);
-        }
+        return (get(SQL_C_NUMERIC, &numeric.value(),
+                    sizeof(::SQL_NUMERIC_STRUCT)));
+    }
 
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_TYPE_TIME,
-            &time.value(), sizeof(::SQL_TIME_STRUCT), &length
-            );
-        if (result != SQL_SUCCESS) {
-            myState.set(State::fail());
-        }
-        ++myColumn;
-        return (*this);
+    Results& Results::operator>> (Time& time)
+    {
+        return (get(SQL_C_TYPE_TIME, &time.value(), sizeof(::SQL_TIME_STRUCT)));
     }
 
     Results& Results::operator>> (Timestamp& timestamp)
     {
-        if (!myState) {
-            return (*this);
-        }
-
-        ::SQLLEN length = 0;
-        ::SQLRETURN result = ::SQLGetData(
-            myStatement.handle().value(), myColumn, SQL_C_TYPE_TIMESTAMP,
-            &timestamp.value(), sizeof(::SQL_TIMESTAMP_STRUCT), &length
-            );
-        if (result != SQL_SUCCESS) {
-            myState.set(State::fail());
-        }
-        ++myColumn;
-        return (*this);
+        return (get(SQL_C_TYPE_TIMESTAMP, &timestamp.value(),
+                    sizeof(::SQL_TIMESTAMP_STRUCT)));
     }
 
     Results& skip (Results& results)
@@ -482,4 +664,16 @@ namespace sql {
         return (results.skip());
     }
 
+    ::SQLRETURN read_string (::SQLHSTMT statement, ::SQLUSMALLINT column,
+                             string& value)
+    {
+        return (::get_string(statement, column, SQL_C_CHAR, value));
+    }
+
+    ::SQLRETURN read_string (::SQLHSTMT statement, ::SQLUSMALLINT column,
+                             wstring& value)
+    {
+        return (::get_string(statement, column, SQL_C_WCHAR, value));
+    }
+
 }
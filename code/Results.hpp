@@ -32,11 +32,13 @@
 #include "NotCopyable.hpp"
 #include "Statement.hpp"
 #include "string.hpp"
+#include "Bytes.hpp"
 #include "Date.hpp"
 #include "Time.hpp"
 #include "Timestamp.hpp"
 #include "Guid.hpp"
 #include "Numeric.hpp"
+#include <vector>
 
 namespace sql {
 
@@ -52,6 +54,7 @@ namespace sql {
     static const Row row;
 
     class Results;
+    template<typename... Types> class Rows;
 
     /*!
      * @brief Skip the next result in the current row.
@@ -72,11 +75,22 @@ namespace sql {
      * This allows reading of individual rows. This object is also called
      * a result set in other libraries. Note that in this case, results on
      * a given row a read by \c Row objects.
+     *
+     * The types used to read the first row are recorded and, starting with
+     * the second row, each column is bound to a buffer so that reading a
+     * value is a copy rather than a driver call.  Skipped columns are left
+     * unbound, and so are character columns unless @c bind_strings() is
+     * enabled.  If a later row is read using different types, or reads a
+     * column that was skipped in the first row, the bindings are released
+     * and the remaining rows are read using per-column driver calls.
      */
     class Results :
         private NotCopyable
     {
         friend Results& skip (Results& results);
+        friend class Batch;
+        friend class ColumnReader;
+        template<typename... Types> friend class Rows;
 
         /* nested types. */
     public:
@@ -197,11 +211,55 @@ namespace sql {
             State operator| (const State& rhs) const;
         };
 
+    private:
+        /*!
+         * @internal
+         * @brief Buffers bound to a single result column.
+         *
+         * Holds one element of @c width bytes and one length indicator per
+         * row in the rowset.
+         */
+        struct Column
+        {
+            /*!
+             * @brief C data type, @c SQL_UNKNOWN_TYPE if the column is not read.
+             */
+            ::SQLSMALLINT type;
+
+            /*!
+             * @brief Size of a single element, in bytes.  0 for columns that
+             *  cannot be bound (e.g. long data).
+             */
+            ::SQLLEN width;
+
+            /*!
+             * @brief Column data, @c width bytes per row.
+             */
+            std::vector<char> data;
+
+            /*!
+             * @brief Length/indicator value, one per row.
+             */
+            std::vector< ::SQLLEN > lengths;
+
+            Column ()
+                : type(SQL_UNKNOWN_TYPE), width(0)
+            {}
+        };
+
         /* data. */
     private:
         Statement& myStatement;
         State myState;
         ::SQLUSMALLINT myColumn;
+        std::vector<Column> myColumns;
+        ::SQLULEN myFetchSize;
+        ::SQLULEN myBinding;
+        ::SQLUSMALLINT myBound;
+        ::SQLULEN myFetched;
+        ::SQLULEN myRow;
+        bool myLearning;
+        bool myStrings;
 
         /* construction. */
     public:
@@ -211,8 +269,15 @@ namespace sql {
          */
         Results (Statement& statement)
             : myStatement(statement), myState(), myColumn(0)
+            , myColumns(), myFetchSize(1), myBinding(0), myBound(0)
+            , myFetched(0), myRow(0), myLearning(true), myStrings(false)
         {}
 
+        /*!
+         * @brief Release column bindings, if any.
+         */
+        ~Results ();
+
         /* methods. */
     public:
         /*!
@@ -272,6 +337,128 @@ namespace sql {
          */
         Results& skip ();
 
+        /*!
+         * @brief Move to the next result set of the statement.
+         * @return @c false if there are no more result sets, in which case
+         *  the results enter the fail state.
+         *
+         * This clears the fail state left by reading past the last row of
+         * the current result set and resets the column bindings, so the
+         * next result set can have a different row layout.  Use @c rows()
+         * to obtain the row count of result sets produced by updates.
+         *
+         * @see Statement::next_result_set()
+         */
+        bool next_result_set ();
+
+        /*!
+         * @brief Read the remaining rows with a typed reader.
+         * @param rows Number of rows fetched per driver call.
+         * @return A reader that binds the columns as @a Types.
+         *
+         * @see Rows
+         */
+        template<typename... Types>
+        Rows<Types...> as (size_t rows = 256);
+
+        /*!
+         * @brief Obtain the number of rows fetched per driver call.
+         * @return The current fetch size, 1 by default.
+         *
+         * @see fetch_size(size_t)
+         */
+        size_t fetch_size () const {
+            return (myFetchSize);
+        }
+
+        /*!
+         * @brief Change the number of rows fetched per driver call.
+         * @param rows Number of rows in each block, at least 1.
+         * @return @a *this, for method chaining.
+         *
+         * Columns are always bound using the types used to read the first
+         * row (see the class description).  With a fetch size larger than 1,
+         * the following rows are fetched @a rows at a time and subsequent
+         * reads must use the same types, in the same columns, as the first
+         * row.  Columns whose length is unbounded (e.g. long text) cannot be
+         * bound; when one of them is read, rows are fetched one at a time.
+         *
+         * The new size takes effect at the next block fetch.
+         */
+        Results& fetch_size (size_t rows);
+
+        /*!
+         * @brief Bind character columns too, using their declared size.
+         * @param enable @c true to bind character columns.
+         * @return @a *this, for method chaining.
+         *
+         * Off by default: the declared size is only a hint with some drivers
+         * (SQLite ignores it, and multibyte values hold more bytes than the
+         * declared number of characters).  When a bound value does not fit,
+         * it is read again using ::SQLGetData().  With a fetch size larger
+         * than 1, this requires a driver that supports ::SQLGetData() on
+         * bound columns in a block (@c SQL_GD_BOUND and @c SQL_GD_BLOCK),
+         * otherwise the results enter the fail state.
+         *
+         * Change this before reading the first row.
+         */
+        Results& bind_strings (bool enable);
+
+    private:
+        /*!
+         * @internal
+         * @brief Record the type used to read the current column.
+         */
+        void learn (::SQLSMALLINT type, ::SQLLEN width);
+
+        /*!
+         * @internal
+         * @brief Bind learned columns and enable block fetches.
+         * @return @c true if the columns are bound.
+         */
+        bool bind ();
+
+        /*!
+         * @internal
+         * @brief Release column buffers and restore single-row fetches.
+         */
+        void unbind () throw();
+
+        /*!
+         * @internal
+         * @brief Release column buffers and stop binding columns.
+         *
+         * Used when a read does not match the bindings, so that the
+         * remaining reads can use ::SQLGetData().
+         */
+        void release () throw();
+
+        /*!
+         * @internal
+         * @brief Find the bound buffer for the current column.
+         * @param type Requested C data type.
+         * @return The column buffers, or 0 if the current column is not
+         *  bound using @a type.
+         */
+        const Column * bound (::SQLSMALLINT type) const;
+
+        /*!
+         * @internal
+         * @brief Read the current column using ::SQLGetData(), when its
+         *  value did not fit in the bound buffer.
+         */
+        template<typename Char>
+        bool reread (::SQLSMALLINT type, basic_string<Char>& value);
+
+        /*!
+         * @internal
+         * @brief Read the current column as a fixed-size value.
+         * @param type Native C data type of @a data.
+         * @param data Destination buffer.
+         * @param size Size of @a data, in bytes.
+         */
+        Results& get (::SQLSMALLINT type, ::SQLPOINTER data, ::SQLLEN size);
+
         /* operators. */
     public:
         /*!
@@ -359,6 +546,18 @@ namespace sql {
          */
         Results& operator>> (wstring& value);
 
+        /*!
+         * @brief Reads the next column into the caller's buffer.
+         *
+         * The value is written straight into the buffer, without an
+         * intermediate copy, so binary columns are never bound.  If the
+         * value does not fit in the buffer, the buffer holds the first
+         * @c value.capacity() bytes and the results enter the fail state.
+         *
+         * @see ColumnReader
+         */
+        Results& operator>> (Bytes& value);
+
         /*!
          * @brief Reads the next column as a date field.
          */
@@ -385,6 +584,24 @@ namespace sql {
         Results& operator>> (Timestamp& value);
     };
 
+    /*!
+     * @internal
+     * @brief Read a character column using ::SQLGetData(), whatever the
+     *  length of its value.
+     * @return The driver's status, @c SQL_SUCCESS if the value was read.
+     */
+    ::SQLRETURN read_string (::SQLHSTMT statement, ::SQLUSMALLINT column,
+                             string& value);
+
+    /*!
+     * @internal
+     * @brief Read a wide character column using ::SQLGetData(), whatever
+     *  the length of its value.
+     * @return The driver's status, @c SQL_SUCCESS if the value was read.
+     */
+    ::SQLRETURN read_string (::SQLHSTMT statement, ::SQLUSMALLINT column,
+                             wstring& value);
+
 }
 
 #endif /* _sql_Results_hpp__ */
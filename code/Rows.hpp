@@ -0,0 +1,481 @@
+#ifndef _sql_Rows_hpp__
+#define _sql_Rows_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+#include "types.hpp"
+#include "string.hpp"
+#include "Bytes.hpp"
+#include "Date.hpp"
+#include "Diagnostic.hpp"
+#include "Guid.hpp"
+#include "Numeric.hpp"
+#include "Results.hpp"
+#include "Time.hpp"
+#include "Timestamp.hpp"
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+namespace sql {
+
+    /*!
+     * @internal
+     * @brief Compile-time binding information for a column type.
+     *
+     * Each specialization provides the C data type, the width of a bound
+     * cell given the column's declared size and the conversion from a bound
+     * cell to a value.
+     */
+    template<typename T> struct column_traits;
+
+    /*!
+     * @internal
+     * @brief Binding information for types that are copied as is.
+     */
+    template<typename T, ::SQLSMALLINT Type>
+    struct scalar_column_traits
+    {
+        static const ::SQLSMALLINT type = Type;
+
+        static ::SQLLEN width (::SQLULEN) {
+            return (sizeof(T));
+        }
+
+        static bool decode (const char * data, ::SQLLEN, ::SQLLEN, T& value)
+        {
+            std::memcpy(&value, data, sizeof(T)); return (true);
+        }
+
+        static ::SQLRETURN reread (::SQLHSTMT, ::SQLUSMALLINT, T&)
+        {
+            return (SQL_ERROR);
+        }
+    };
+
+    /*!
+     * @internal
+     * @brief Binding information for types that wrap an ODBC structure.
+     */
+    template<typename T, ::SQLSMALLINT Type>
+    struct native_column_traits
+    {
+        static const ::SQLSMALLINT type = Type;
+
+        static ::SQLLEN width (::SQLULEN) {
+            return (sizeof(typename T::Value));
+        }
+
+        static bool decode (const char * data, ::SQLLEN, ::SQLLEN, T& value)
+        {
+            std::memcpy(&value.value(), data, sizeof(typename T::Value));
+            return (true);
+        }
+
+        static ::SQLRETURN reread (::SQLHSTMT, ::SQLUSMALLINT, T&)
+        {
+            return (SQL_ERROR);
+        }
+    };
+
+    /*!
+     * @internal
+     * @brief Binding information for character data.
+     *
+     * Cells are sized using the column's declared size, up to
+     * @c max_width characters.  Longer values are read again using
+     * ::SQLGetData().
+     */
+    template<typename Char, ::SQLSMALLINT Type>
+    struct string_column_traits
+    {
+        static const ::SQLSMALLINT type = Type;
+        static const ::SQLULEN max_width = 4096;
+
+        static ::SQLLEN width (::SQLULEN size)
+        {
+            if ((size == 0) || (size > max_width)) {
+                size = max_width;
+            }
+            return ((size+1)*sizeof(Char));
+        }
+
+        static bool decode (const char * data, ::SQLLEN length,
+                            ::SQLLEN width, basic_string<Char>& value)
+        {
+            if ((length == SQL_NO_TOTAL) || (length >= width)) {
+                return (false);
+            }
+            const Char *const first = reinterpret_cast<const Char*>(data);
+            value.assign(first, first+(length/sizeof(Char)));
+            return (true);
+        }
+
+        static ::SQLRETURN reread (::SQLHSTMT statement,
+                                   ::SQLUSMALLINT column,
+                                   basic_string<Char>& value)
+        {
+            return (read_string(statement, column, value));
+        }
+    };
+
+    template<> struct column_traits<int8> :
+        scalar_column_traits<int8, SQL_C_STINYINT> {};
+    template<> struct column_traits<uint8> :
+        scalar_column_traits<uint8, SQL_C_UTINYINT> {};
+    template<> struct column_traits<int16> :
+        scalar_column_traits<int16, SQL_C_SSHORT> {};
+    template<> struct column_traits<uint16> :
+        scalar_column_traits<uint16, SQL_C_USHORT> {};
+    template<> struct column_traits<int32> :
+        scalar_column_traits<int32, SQL_C_SLONG> {};
+    template<> struct column_traits<uint32> :
+        scalar_column_traits<uint32, SQL_C_ULONG> {};
+    template<> struct column_traits<int64> :
+        scalar_column_traits<int64, SQL_C_SBIGINT> {};
+    template<> struct column_traits<uint64> :
+        scalar_column_traits<uint64, SQL_C_UBIGINT> {};
+    template<> struct column_traits<float> :
+        scalar_column_traits<float, SQL_C_FLOAT> {};
+    template<> struct column_traits<double> :
+        scalar_column_traits<double, SQL_C_DOUBLE> {};
+    template<> struct column_traits<string> :
+        string_column_traits<character, SQL_C_CHAR> {};
+    template<> struct column_traits<wstring> :
+        string_column_traits<wcharacter, SQL_C_WCHAR> {};
+    template<> struct column_traits<Date> :
+        native_column_traits<Date, SQL_C_TYPE_DATE> {};
+    template<> struct column_traits<Guid> :
+        native_column_traits<Guid, SQL_C_GUID> {};
+    template<> struct column_traits<Numeric> :
+        native_column_traits<Numeric, SQL_C_NUMERIC> {};
+    template<> struct column_traits<Time> :
+        native_column_traits<Time, SQL_C_TYPE_TIME> {};
+    template<> struct column_traits<Timestamp> :
+        native_column_traits<Timestamp, SQL_C_TYPE_TIMESTAMP> {};
+
+    /*!
+     * @internal
+     * @brief Compile-time sequence of column indices.
+     */
+    template<std::size_t... I> struct indices {};
+
+    /*!
+     * @internal
+     * @brief Generate @c indices<0,1,...,N-1>.
+     */
+    template<std::size_t N, std::size_t... I>
+    struct make_indices :
+        make_indices<N-1, N-1, I...>
+    {
+    };
+
+    template<std::size_t... I>
+    struct make_indices<0, I...>
+    {
+        typedef indices<I...> type;
+    };
+
+    /*!
+     * @brief Typed reader for result sets with a known row layout.
+     *
+     * The column types are fixed at compile time, so all columns are bound
+     * once, rows are fetched in blocks and each row is decoded without any
+     * per-column run-time type checks.  Rows are read into a @c std::tuple
+     * of the column types, or into any aggregate whose members are
+     * initialized by the column values, in order:
+     * @code
+     *  struct Entry { sql::int32 id; sql::string name; };
+     *
+     *  sql::Rows<sql::int32, sql::string> rows =
+     *      results.as<sql::int32, sql::string>();
+     *  Entry entry;
+     *  while (rows >> entry) {
+     *    // ...
+     *  }
+     * @endcode
+     *
+     * Null values are read as value-initialized objects; use @c null() to
+     * tell them apart.  The reader takes over the result set's cursor:
+     * @a results should not be read from while the reader exists.
+     *
+     * @see Results::as()
+     */
+    template<typename... Types>
+    class Rows
+    {
+        static_assert(sizeof...(Types) > 0, "Rows need at least one column.");
+
+        /* nested types. */
+    private:
+        struct Column
+        {
+            ::SQLLEN width;
+            std::vector<char> data;
+            std::vector< ::SQLLEN > lengths;
+        };
+
+        typedef typename make_indices<sizeof...(Types)>::type Indices;
+
+        /* class data. */
+    public:
+        /*!
+         * @brief Number of columns in each row.
+         */
+        static const std::size_t columns = sizeof...(Types);
+
+        /* data. */
+    private:
+        Results * myResults;
+        Column myColumns[columns];
+        ::SQLULEN myFetched;
+        ::SQLULEN myRow;
+        bool myGood;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Bind the columns of @a results.
+         * @param results Result set with (at least) the columns in @a Types.
+         * @param rows Number of rows fetched per driver call.
+         */
+        explicit Rows (Results& results, size_t rows = 256)
+            : myResults(&results), myFetched(0), myRow(0)
+            , myGood(results)
+        {
+            if (!myGood) {
+                return;
+            }
+            results.release();
+            if (rows < 1) {
+                rows = 1;
+            }
+
+            const ::SQLSMALLINT types[] = { column_traits<Types>::type... };
+            ::SQLLEN (*const widths[])(::SQLULEN) = {
+                &column_traits<Types>::width...
+            };
+            const std::vector<ColumnInfo>& info =
+                results.statement().columns();
+            const ::SQLHSTMT statement = handle().value();
+            for (std::size_t i = 0; (i < columns); ++i)
+            {
+                const ::SQLULEN size = (i < info.size())? info[i].size() : 0;
+                Column& column = myColumns[i];
+                column.width = (*widths[i])(size);
+                column.data.resize(rows*column.width);
+                column.lengths.resize(rows);
+                const ::SQLRETURN result = ::SQLBindCol(
+                    statement, static_cast< ::SQLUSMALLINT >(i+1), types[i],
+                    &column.data[0], column.width, &column.lengths[0]
+                    );
+                if (result != SQL_SUCCESS) {
+                    fail();
+                }
+            }
+            ::SQLRETURN result = ::SQLSetStmtAttr(
+                statement, SQL_ATTR_ROW_ARRAY_SIZE,
+                reinterpret_cast< ::SQLPOINTER >(::SQLULEN(rows)), 0
+                );
+            if (result == SQL_SUCCESS) {
+                result = ::SQLSetStmtAttr(
+                    statement, SQL_ATTR_ROWS_FETCHED_PTR, &myFetched, 0
+                    );
+            }
+            if (result != SQL_SUCCESS) {
+                fail();
+            }
+        }
+
+        /*!
+         * @brief Take over the bindings of @a other.
+         */
+        Rows (Rows&& other)
+            : myResults(other.myResults), myFetched(other.myFetched)
+            , myRow(other.myRow), myGood(other.myGood)
+        {
+            for (std::size_t i = 0; (i < columns); ++i)
+            {
+                myColumns[i].width = other.myColumns[i].width;
+                myColumns[i].data.swap(other.myColumns[i].data);
+                myColumns[i].lengths.swap(other.myColumns[i].lengths);
+            }
+            other.myResults = 0;
+
+                // Buffers are moved, but the row count is not.
+            if (myResults && myGood) {
+                ::SQLSetStmtAttr(
+                    handle().value(), SQL_ATTR_ROWS_FETCHED_PTR, &myFetched, 0
+                    );
+            }
+        }
+
+        Rows (const Rows&) = delete;
+        Rows& operator= (const Rows&) = delete;
+
+        /*!
+         * @brief Release the column bindings.
+         */
+        ~Rows ()
+        {
+            if (myResults) {
+                unbind();
+            }
+        }
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Check if a column of the current row is null.
+         * @param column Zero-based column index.
+         */
+        bool null (std::size_t column) const
+        {
+            return (myColumns[column].lengths[myRow] == SQL_NULL_DATA);
+        }
+
+    private:
+        const Handle& handle () const {
+            return (myResults->handle());
+        }
+
+        void unbind () throw()
+        {
+            const ::SQLHSTMT statement = handle().value();
+            ::SQLFreeStmt(statement, SQL_UNBIND);
+            ::SQLSetStmtAttr(
+                statement, SQL_ATTR_ROW_ARRAY_SIZE,
+                reinterpret_cast< ::SQLPOINTER >(::SQLULEN(1)), 0
+                );
+            ::SQLSetStmtAttr(statement, SQL_ATTR_ROWS_FETCHED_PTR, 0, 0);
+        }
+
+        void fail ()
+        {
+            const Diagnostic diagnostic(handle());
+            unbind();
+            myResults->myState.set(Results::State::fail());
+            myResults = 0;
+            throw (diagnostic);
+        }
+
+        template<std::size_t I>
+        typename std::tuple_element< I, std::tuple<Types...> >::type decode ()
+        {
+            typedef typename std::tuple_element<
+                I, std::tuple<Types...> >::type Value;
+            typedef column_traits<Value> Traits;
+
+            Value value = Value();
+            const Column& column = myColumns[I];
+            const ::SQLLEN length = column.lengths[myRow];
+            if ((length != SQL_NULL_DATA) && !Traits::decode(
+                    &column.data[myRow*column.width], length,
+                    column.width, value))
+            {
+                    // Longer than its cell (e.g. the declared size is only
+                    // a hint): read the value from the current row.
+                const ::SQLHSTMT statement = handle().value();
+                ::SQLRETURN result = ::SQLSetPos(
+                    statement, static_cast< ::SQLSETPOSIROW >(myRow+1),
+                    SQL_POSITION, SQL_LOCK_NO_CHANGE
+                    );
+                if (result == SQL_SUCCESS) {
+                    result = Traits::reread(
+                        statement, static_cast< ::SQLUSMALLINT >(I+1), value
+                        );
+                }
+                if (result != SQL_SUCCESS) {
+                    fail();
+                }
+            }
+            return (value);
+        }
+
+        template<typename Row, std::size_t... I>
+        void decode (Row& row, indices<I...>)
+        {
+                // Braced initializers are evaluated in order.
+            row = Row{ decode<I>()... };
+        }
+
+        /* operators. */
+    public:
+        /*!
+         * @brief Read the next row.
+         * @param row Tuple or aggregate initialized from the column values.
+         * @return @c *this, for method chaining.
+         * @throw Diagnostic The driver could not fetch the next rows.
+         */
+        template<typename Row>
+        Rows& operator>> (Row& row)
+        {
+            if (!*this) {
+                return (*this);
+            }
+            if (++myRow >= myFetched)
+            {
+                myRow = 0;
+                myFetched = 0;
+                const ::SQLRETURN result = ::SQLFetch(handle().value());
+                if ((result != SQL_SUCCESS) &&
+                    (result != SQL_SUCCESS_WITH_INFO) &&
+                    (result != SQL_NO_DATA))
+                {
+                    fail();
+                }
+                if ((result == SQL_NO_DATA) || (myFetched == 0))
+                {
+                    myResults->myState.set(Results::State::fail());
+                    myGood = false;
+                    return (*this);
+                }
+            }
+            decode(row, Indices());
+            return (*this);
+        }
+
+        /*!
+         * @brief Check if the last row was read.
+         *
+         * The reader fails at the end of the result set.
+         */
+        operator bool () const {
+            return (myResults && myGood);
+        }
+    };
+
+    template<typename... Types>
+    Rows<Types...> Results::as (size_t rows)
+    {
+        return (Rows<Types...>(*this, rows));
+    }
+
+}
+
+#endif /* _sql_Rows_hpp__ */
@@ -26,31 +26,35 @@
 
 #include "Statement.hpp"
 #include "Diagnostic.hpp"
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
 
 namespace {
 
-    ::SQLHANDLE allocate (sql::Connection& connection)
-    {
-        ::SQLHANDLE value = SQL_NULL_HANDLE;
-        const ::SQLRETURN result = ::SQLAllocHandle(
-            SQL_HANDLE_STMT, connection.handle().value(), &value
-            );
-        if (result != SQL_SUCCESS) {
-            throw (sql::Diagnostic(connection.handle()));
-        }
-        return (value);
-    }
+        // Numbers result sets across all statements.
+    std::atomic<sql::uint64> result_sets(0);
 
 }
 
 namespace sql {
 
     Statement::Statement (Connection& connection)
-        : myHandle(::allocate(connection), SQL_HANDLE_STMT, &Handle::claim)
+        : myConnection(connection)
+        , myHandle(connection.acquire_statement(),
+                   SQL_HANDLE_STMT, &Handle::proxy)
+        , myColumns(), myDescribed(false), myResultSet(0)
+        , myExecuting(false), myPuttingData(false), myToken(0)
     {
     }
 
+    Statement::~Statement ()
+    {
+        myConnection.release_statement(myHandle.value());
+    }
+
     const Handle& Statement::handle () const throw()
     {
         return (myHandle);
@@ -58,7 +62,76 @@ namespace sql {
 
     Statement& Statement::execute ()
     {
-        ::SQLRETURN result = ::SQLExecute(handle().value());
+            // Statements in asynchronous mode are simply waited for.
+        if (!start()) {
+            while (!poll()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        return (*this);
+    }
+
+    bool Statement::asynchronous (bool enabled)
+    {
+        const ::SQLULEN mode =
+            enabled? SQL_ASYNC_ENABLE_ON : SQL_ASYNC_ENABLE_OFF;
+        const ::SQLRETURN result = ::SQLSetStmtAttr(
+            handle().value(), SQL_ATTR_ASYNC_ENABLE,
+            reinterpret_cast< ::SQLPOINTER >(mode), 0
+            );
+        return (result == SQL_SUCCESS);
+    }
+
+    bool Statement::start ()
+    {
+        if (myExecuting) {
+            throw (std::logic_error(
+                "sql::Statement: execution already in progress."
+                ));
+        }
+        invalidate_columns();
+        before_execute();
+        myExecuting = true, myPuttingData = false;
+        return (advance(::SQLExecute(handle().value())));
+    }
+
+    bool Statement::poll ()
+    {
+        if (!myExecuting) {
+            return (true);
+        }
+        return (advance(myPuttingData?
+            ::SQLParamData(handle().value(), &myToken) :
+            ::SQLExecute(handle().value())));
+    }
+
+    bool Statement::executing () const
+    {
+        return (myExecuting);
+    }
+
+    bool Statement::advance (::SQLRETURN result)
+    {
+        try {
+                // Send parameters supplied at execution, one at a time.
+            while (result == SQL_NEED_DATA)
+            {
+                if (myPuttingData) {
+                    put_data(myToken);
+                }
+                myPuttingData = true;
+                result = ::SQLParamData(handle().value(), &myToken);
+            }
+        }
+        catch ( ... ) {
+            ::SQLCancel(handle().value());
+            myExecuting = false;
+            throw;
+        }
+        if (result == SQL_STILL_EXECUTING) {
+            return (false);
+        }
+        myExecuting = false;
         if ((result != SQL_SUCCESS) && (result != SQL_NO_DATA))
         {
             const Diagnostic diagnostic(handle());
@@ -69,7 +142,114 @@ namespace sql {
                 throw (diagnostic);
             }
         }
-        return (*this);
+        after_execute();
+        return (true);
+    }
+
+    void Statement::before_execute ()
+    {
+    }
+
+    void Statement::after_execute ()
+    {
+    }
+
+    const std::vector<ColumnInfo>& Statement::columns () const
+    {
+        if (myDescribed) {
+            return (myColumns);
+        }
+
+        ::SQLSMALLINT count = 0;
+        ::SQLRETURN result = ::SQLNumResultCols(handle().value(), &count);
+        if (result != SQL_SUCCESS) {
+            throw (Diagnostic(handle()));
+        }
+        std::vector<ColumnInfo> columns;
+        columns.reserve(count);
+        for (::SQLUSMALLINT i = 1; (i <= count); ++i)
+        {
+            std::vector<character> name(256);
+            ::SQLSMALLINT length = 0;
+            ::SQLSMALLINT type = SQL_UNKNOWN_TYPE;
+            ::SQLULEN size = 0;
+            ::SQLSMALLINT digits = 0;
+            ::SQLSMALLINT nullable = SQL_NULLABLE_UNKNOWN;
+            result = ::SQLDescribeCol(
+                handle().value(), i, &name[0], name.size(), &length,
+                &type, &size, &digits, &nullable
+                );
+
+                // Retry once with room for the whole name.
+            if ((result == SQL_SUCCESS_WITH_INFO) &&
+                (static_cast<std::size_t>(length) >= name.size()))
+            {
+                name.resize(length+1);
+                result = ::SQLDescribeCol(
+                    handle().value(), i, &name[0], name.size(), &length,
+                    &type, &size, &digits, &nullable
+                    );
+            }
+            if ((result != SQL_SUCCESS) && (result != SQL_SUCCESS_WITH_INFO)) {
+                throw (Diagnostic(handle()));
+            }
+            if (static_cast<std::size_t>(length) >= name.size()) {
+                length = static_cast< ::SQLSMALLINT >(name.size()-1);
+            }
+            string text;
+            text.assign(&name[0], &name[0]+length);
+            columns.push_back(
+                ColumnInfo(text, type, size, digits, nullable)
+                );
+        }
+        myColumns.swap(columns);
+        myDescribed = true;
+        return (myColumns);
+    }
+
+    size_t Statement::rows () const
+    {
+        ::SQLLEN count = 0;
+        const ::SQLRETURN result = ::SQLRowCount(handle().value(), &count);
+        if (result != SQL_SUCCESS) {
+            throw (Diagnostic(handle()));
+        }
+        return (count);
+    }
+
+    bool Statement::next_result_set ()
+    {
+        const ::SQLRETURN result = ::SQLMoreResults(handle().value());
+        if (result == SQL_NO_DATA) {
+            return (false);
+        }
+        if ((result != SQL_SUCCESS) && (result != SQL_SUCCESS_WITH_INFO)) {
+            throw (Diagnostic(handle()));
+        }
+        invalidate_columns();
+        return (true);
+    }
+
+    void Statement::close_cursor ()
+    {
+        const ::SQLRETURN result = ::SQLFreeStmt(handle().value(), SQL_CLOSE);
+        if (result != SQL_SUCCESS) {
+            throw (Diagnostic(handle()));
+        }
+    }
+
+    void Statement::invalidate_columns () const
+    {
+        myColumns.clear();
+        myDescribed = false;
+        myResultSet = ++::result_sets;
+    }
+
+    void Statement::put_data (::SQLPOINTER)
+    {
+        throw (std::invalid_argument(
+            "sql::Statement: no parameter data to send."
+            ));
     }
 
     Statement& Statement::cancel ()
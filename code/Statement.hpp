@@ -28,8 +28,10 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "types.hpp"
+#include "ColumnInfo.hpp"
 #include "Connection.hpp"
 #include "NotCopyable.hpp"
+#include <vector>
 
 namespace sql {
 
@@ -46,9 +48,20 @@ namespace sql {
     {
         /* members. */
     private:
-            // Hold (and automagically release) the connection data.
+            // Drawn from (and returned to) the connection's pool.
+        Connection& myConnection;
         Handle myHandle;
 
+            // Result set description, computed on first use.
+        mutable std::vector<ColumnInfo> myColumns;
+        mutable bool myDescribed;
+        mutable uint64 myResultSet;
+
+            // Execution in progress, for asynchronous mode.
+        bool myExecuting;
+        bool myPuttingData;
+        ::SQLPOINTER myToken;
+
         /* construction. */
     public:
             /*!
@@ -62,6 +75,11 @@ namespace sql {
              */
         Statement (Connection& connection);
 
+            /*!
+             * @brief Return the statement handle to the connection's pool.
+             */
+        virtual ~Statement ();
+
         /* methods. */
     public:
             /*!
@@ -80,16 +98,127 @@ namespace sql {
          * @brief Cancel asynchronous operation or paused execution.
          *
          * Statement execution is paused when using data at exection.
-         *
-         * @note Asynchronous operation is not yet supported.
-         * @note Data at execution is not yet supported.
          */
         Statement& cancel ();
 
+        /*!
+         * @brief Describe the columns of the result set.
+         * @return One entry per column, empty if the statement does not
+         *  generate results.
+         *
+         * The description is obtained from the driver on first use and
+         * cached until the statement is executed again, so buffers can be
+         * sized from it without repeated driver calls.
+         */
+        const std::vector<ColumnInfo>& columns () const;
+
+        /*!
+         * @brief Count the rows affected by the current result set.
+         * @return The number of rows changed by an update, insert or delete
+         *  statement; often -1 for queries.
+         */
+        size_t rows () const;
+
+        /*!
+         * @brief Identify the current result set.
+         * @return A value that changes whenever the statement is executed or
+         *  moves to its next result set.  Values are never reused, not even
+         *  by other statements.
+         */
+        uint64 result_set () const {
+            return (myResultSet);
+        }
+
+        /*!
+         * @brief Move to the next result set.
+         * @return @c false if there are no more result sets.
+         *
+         * Batches of statements and stored procedures may produce several
+         * result sets (or row counts), which are consumed in order.  Any
+         * unread rows in the current result set are discarded.
+         */
+        bool next_result_set ();
+
+        /*!
+         * @brief Close the cursor, discarding any unread results.
+         *
+         * Does nothing if no cursor is open.  The statement can then be
+         * executed again.
+         */
+        void close_cursor ();
+
             /*!
              * @brief Executes as a prepared statement, and \c reset()s.
              */
         virtual Statement& execute ();
+
+        /*!
+         * @brief Switch asynchronous execution on or off.
+         * @param enabled @c true for @c SQL_ASYNC_ENABLE_ON.
+         * @return @c false if the driver does not support the mode.
+         *
+         * Only @c start() and @c poll() support asynchronous mode: switch
+         * it off before fetching results.
+         */
+        bool asynchronous (bool enabled);
+
+        /*!
+         * @brief Start executing the statement.
+         * @return @c true if the execution is complete.
+         *
+         * This is the same as @c execute(), except that a statement in
+         * asynchronous mode (@c SQL_ATTR_ASYNC_ENABLE) returns as soon as the
+         * driver reports it is still executing.  Call @c poll() until it
+         * returns @c true.
+         *
+         * @see Execution
+         */
+        bool start ();
+
+        /*!
+         * @brief Continue an execution started by @c start().
+         * @return @c true if the execution is complete.
+         *
+         * Errors are reported by throwing, as by @c execute().
+         */
+        bool poll ();
+
+        /*!
+         * @brief Check if an execution was started and is not complete.
+         */
+        bool executing () const;
+
+    protected:
+        /*!
+         * @brief Discard the cached result set description.
+         *
+         * Call this whenever the statement produces a new result set.
+         */
+        void invalidate_columns () const;
+
+        /*!
+         * @brief Send the value of a parameter supplied at execution.
+         * @param token Value passed to ::SQLBindParameter() for the
+         *  parameter the driver is waiting for.
+         *
+         * Called by @c execute() for each such parameter, in turn.  Send the
+         * value using ::SQLPutData().  The default implementation throws, as
+         * plain statements have no parameters.
+         */
+        virtual void put_data (::SQLPOINTER token);
+
+        /*!
+         * @brief Called when execution starts, before the driver is called.
+         */
+        virtual void before_execute ();
+
+        /*!
+         * @brief Called when execution completes successfully.
+         */
+        virtual void after_execute ();
+
+    private:
+        bool advance (::SQLRETURN result);
     };
 
 }
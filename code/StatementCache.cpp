@@ -0,0 +1,108 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "StatementCache.hpp"
+#include "PreparedStatement.hpp"
+
+namespace {
+
+    std::string key (const sql::string& text)
+    {
+        return (std::string(text.c_str(), text.length()));
+    }
+
+}
+
+namespace sql {
+
+    StatementCache::StatementCache (Connection& connection, size_t capacity)
+        : myConnection(connection)
+        , myCapacity((capacity > 0)? capacity : 1)
+        , myEntries()
+        , myIndex()
+        , myHits(0)
+        , myMisses(0)
+    {
+    }
+
+    StatementCache::~StatementCache ()
+    {
+        invalidate();
+    }
+
+    PreparedStatement& StatementCache::prepare (const string& text)
+    {
+        const std::string name = ::key(text);
+        const Index::iterator match = myIndex.find(name);
+        if (match != myIndex.end())
+        {
+                // Move to the front of the list (most recently used).
+            myEntries.splice(myEntries.begin(), myEntries, match->second);
+            ++myHits;
+
+                // The last user may have stopped reading before the end.
+            PreparedStatement& statement = *myEntries.front().second;
+            statement.close_cursor();
+            return (statement.reset());
+        }
+
+        ++myMisses;
+        PreparedStatement *const statement =
+            new PreparedStatement(myConnection, text);
+        if (myEntries.size() >= std::size_t(myCapacity))
+        {
+            delete myEntries.back().second;
+            myIndex.erase(myEntries.back().first);
+            myEntries.pop_back();
+        }
+        myEntries.push_front(Entry(name, statement));
+        myIndex[name] = myEntries.begin();
+        return (*statement);
+    }
+
+    void StatementCache::invalidate (const string& text)
+    {
+        const Index::iterator match = myIndex.find(::key(text));
+        if (match == myIndex.end()) {
+            return;
+        }
+        delete match->second->second;
+        myEntries.erase(match->second);
+        myIndex.erase(match);
+    }
+
+    void StatementCache::invalidate ()
+    {
+        for (Entries::iterator entry = myEntries.begin();
+             (entry != myEntries.end()); ++entry)
+        {
+            delete entry->second;
+        }
+        myEntries.clear();
+        myIndex.clear();
+    }
+
+}
@@ -0,0 +1,151 @@
+#ifndef _sql_StatementCache_hpp__
+#define _sql_StatementCache_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+#include "types.hpp"
+#include "string.hpp"
+#include "NotCopyable.hpp"
+#include <list>
+#include <map>
+#include <string>
+
+namespace sql {
+
+    class Connection;
+    class PreparedStatement;
+
+    /*!
+     * @brief Least-recently-used cache of prepared statements.
+     *
+     * Preparing a statement is a round trip to the database.  Code that runs
+     * the same statements over and over can look them up by SQL text
+     * instead, and only pay for preparation once:
+     * @code
+     *  sql::StatementCache statements(connection);
+     *  // ...
+     *  sql::PreparedStatement& statement =
+     *      statements.prepare("select name from users where id = ?;");
+     *  sql::Results results(statement << id << sql::execute);
+     * @endcode
+     *
+     * When the cache is full, preparing a new statement evicts the least
+     * recently used one.  References returned by @c prepare() are therefore
+     * only valid until the next call to @c prepare() or @c invalidate().
+     *
+     * The cache must be destroyed before its connection.
+     */
+    class StatementCache :
+        private NotCopyable
+    {
+        /* nested types. */
+    private:
+        typedef std::pair<std::string, PreparedStatement*> Entry;
+        typedef std::list<Entry> Entries;
+        typedef std::map<std::string, Entries::iterator> Index;
+
+        /* data. */
+    private:
+        Connection& myConnection;
+        size_t myCapacity;
+        Entries myEntries;
+        Index myIndex;
+        size_t myHits;
+        size_t myMisses;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Create an empty cache.
+         * @param connection Connection on which statements are prepared.
+         * @param capacity Maximum number of statements kept prepared.
+         */
+        explicit StatementCache (Connection& connection, size_t capacity=64);
+
+        /*!
+         * @brief Release all statements.
+         */
+        ~StatementCache ();
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Obtain a prepared statement for @a text.
+         * @param text SQL statement text.
+         * @return A statement ready to bind parameters to.
+         *
+         * A cached statement is reset and its cursor is closed, even if the
+         * previous user did not read all of its results.
+         */
+        PreparedStatement& prepare (const string& text);
+
+        /*!
+         * @brief Release the statement for @a text, if any.
+         *
+         * Use this when the statement's plan is no longer valid, for
+         * example after a schema change.
+         */
+        void invalidate (const string& text);
+
+        /*!
+         * @brief Release all statements.
+         */
+        void invalidate ();
+
+        /*!
+         * @brief Number of statements currently prepared.
+         */
+        size_t size () const {
+            return (myEntries.size());
+        }
+
+        /*!
+         * @brief Maximum number of statements kept prepared.
+         */
+        size_t capacity () const {
+            return (myCapacity);
+        }
+
+        /*!
+         * @brief Number of calls to @c prepare() served from the cache.
+         */
+        size_t hits () const {
+            return (myHits);
+        }
+
+        /*!
+         * @brief Number of calls to @c prepare() that prepared a statement.
+         */
+        size_t misses () const {
+            return (myMisses);
+        }
+    };
+
+}
+
+#endif /* _sql_StatementCache_hpp__ */
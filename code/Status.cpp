@@ -49,6 +49,16 @@ namespace sql {
         return (Status((const character*)"01004"));
     }
 
+    const Status Status::invalid_attribute ()
+    {
+        return (Status((const character*)"HY092"));
+    }
+
+    const Status Status::not_implemented ()
+    {
+        return (Status((const character*)"HYC00"));
+    }
+
     Status::Status () throw ()
     {
         std::memset(myValue,0,6*sizeof(character));
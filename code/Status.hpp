@@ -61,6 +61,16 @@ namespace sql {
          */
         static const Status string_truncated ();
 
+        /*!
+         * @brief Invalid attribute or option identifier.
+         */
+        static const Status invalid_attribute ();
+
+        /*!
+         * @brief The driver does not support the requested feature.
+         */
+        static const Status not_implemented ();
+
         /* data. */
     private:
             // Standard 5 characters, plus a null terminator.
@@ -0,0 +1,132 @@
+#ifndef _sql_Stream_hpp__
+#define _sql_Stream_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+#include "types.hpp"
+#include <functional>
+#include <istream>
+
+namespace sql {
+
+    /*!
+     * @brief Parameter value sent in chunks while the statement executes.
+     *
+     * The value is pulled from a @c std::istream or from a callback when the
+     * statement is executed, one chunk at a time, so large values need not
+     * be held in memory.  Like @c Bytes, this refers to the caller's source,
+     * which must remain valid until the statement is executed.
+     *
+     * @code
+     *  std::ifstream file("image.png", std::ios::binary);
+     *  statement << sql::Stream(file) << sql::execute;
+     * @endcode
+     */
+    class Stream
+    {
+        /* nested types. */
+    public:
+        /*!
+         * @brief Callback that fills @a data with at most @a size bytes.
+         * @return The number of bytes written, 0 at the end of the value.
+         */
+        typedef std::function<size_t(char * data, size_t size)> Source;
+
+        /* data. */
+    private:
+        std::istream * myStream;
+        Source mySource;
+        size_t myLength;
+        bool myBinary;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Send the contents of @a stream, up to its end.
+         * @param stream Input stream, read when the statement is executed.
+         * @param length Size of the value, in bytes, or -1 if unknown.  Some
+         *  drivers require the length to be known in advance.
+         * @param binary @c true to send bytes, @c false to send text.
+         */
+        Stream (std::istream& stream, size_t length=-1, bool binary=true)
+            : myStream(&stream)
+            , mySource()
+            , myLength(length)
+            , myBinary(binary)
+        {}
+
+        /*!
+         * @brief Send what @a source produces, until it returns 0.
+         * @param source Callback, invoked when the statement is executed.
+         * @param length Size of the value, in bytes, or -1 if unknown.  Some
+         *  drivers require the length to be known in advance.
+         * @param binary @c true to send bytes, @c false to send text.
+         */
+        Stream (const Source& source, size_t length=-1, bool binary=true)
+            : myStream(0)
+            , mySource(source)
+            , myLength(length)
+            , myBinary(binary)
+        {}
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Size of the value, in bytes.
+         * @return -1 if the size is not known in advance.
+         */
+        size_t length () const {
+            return (myLength);
+        }
+
+        /*!
+         * @brief Check if the value is sent as bytes rather than as text.
+         */
+        bool binary () const {
+            return (myBinary);
+        }
+
+        /*!
+         * @brief Obtain the next chunk of the value.
+         * @param data Buffer that receives the chunk.
+         * @param size Size of the buffer, in bytes.
+         * @return The number of bytes written, 0 at the end of the value.
+         */
+        size_t read (char * data, size_t size) const
+        {
+            if (myStream == 0) {
+                return (mySource(data, size));
+            }
+            myStream->read(data, size);
+            return (myStream->gcount());
+        }
+    };
+
+}
+
+#endif /* _sql_Stream_hpp__ */
@@ -38,4 +38,9 @@
 #include <sqltypes.h>
 #include <sqlext.h>
 
+    // C++20 coroutines, for the awaitable interface (see "coroutine.hpp").
+#if (defined(__cpp_impl_coroutine) && (__cpp_impl_coroutine >= 201902L))
+#   define SQLXX_COROUTINES 1
+#endif
+
 #endif /* _sql_configure_hpp__ */
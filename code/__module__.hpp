@@ -32,20 +32,35 @@
  */
 namespace sql {}
 
+#include "AffinityPool.hpp"
+#include "Batch.hpp"
+#include "BulkLoader.hpp"
+#include "Bytes.hpp"
 #include "catalog.hpp"
+#include "ColumnInfo.hpp"
+#include "ColumnReader.hpp"
 #include "Connection.hpp"
+#include "ConnectionPool.hpp"
+#include "coroutine.hpp"
 #include "Date.hpp"
 #include "Diagnostic.hpp"
 #include "Driver.hpp"
 #include "Environment.hpp"
+#include "Execution.hpp"
 #include "execute.hpp"
 #include "Guid.hpp"
 #include "Handle.hpp"
 #include "Numeric.hpp"
+#include "Output.hpp"
+#include "Pooling.hpp"
 #include "PreparedStatement.hpp"
+#include "query.hpp"
 #include "Results.hpp"
+#include "Rows.hpp"
 #include "Statement.hpp"
+#include "StatementCache.hpp"
 #include "Status.hpp"
+#include "Stream.hpp"
 #include "Time.hpp"
 #include "Timestamp.hpp"
 #include "Transaction.hpp"
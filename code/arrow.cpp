@@ -0,0 +1,341 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "arrow.hpp"
+#include "Date.hpp"
+#include "Guid.hpp"
+#include "Numeric.hpp"
+#include "Time.hpp"
+#include "Timestamp.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+namespace {
+
+    // Storage owned by an exported schema.
+    struct Schema
+    {
+        std::string format;
+        std::string name;
+        std::vector< ::ArrowSchema* > children;
+    };
+
+    // Storage owned by an exported array.
+    struct Array
+    {
+        std::vector<char> data;
+        std::vector<sql::int32> offsets;
+        std::vector<sql::uint8> validity;
+        std::vector<const void*> buffers;
+        std::vector< ::ArrowArray* > children;
+    };
+
+    void release_schema (::ArrowSchema * schema)
+    {
+        Schema *const owner = static_cast<Schema*>(schema->private_data);
+        for (std::size_t i = 0; (i < owner->children.size()); ++i)
+        {
+            ::ArrowSchema *const child = owner->children[i];
+            if (child->release != 0) {
+                child->release(child);
+            }
+            delete child;
+        }
+        delete owner;
+        schema->release = 0;
+    }
+
+    void release_array (::ArrowArray * array)
+    {
+        Array *const owner = static_cast<Array*>(array->private_data);
+        for (std::size_t i = 0; (i < owner->children.size()); ++i)
+        {
+            ::ArrowArray *const child = owner->children[i];
+            if (child->release != 0) {
+                child->release(child);
+            }
+            delete child;
+        }
+        delete owner;
+        array->release = 0;
+    }
+
+    std::string format (const sql::Batch::Column& column)
+    {
+        if (column.is_int8()) {
+            return ("c");
+        }
+        if (column.is_int16()) {
+            return ("s");
+        }
+        if (column.is_int32()) {
+            return ("i");
+        }
+        if (column.is_int64()) {
+            return ("l");
+        }
+        if (column.is_float()) {
+            return ("f");
+        }
+        if (column.is_double()) {
+            return ("g");
+        }
+        if (column.is_date()) {
+            return ("tdD");
+        }
+        if (column.is_time()) {
+            return ("tts");
+        }
+        if (column.is_timestamp()) {
+            return ("tsn:");
+        }
+        if (column.is_guid()) {
+            return ("w:16");
+        }
+        if (column.is_numeric())
+        {
+            std::ostringstream format;
+            format << "d:" << column.precision() << ',' << column.scale();
+            return (format.str());
+        }
+        return ("u");
+    }
+
+    // Days since 1970-01-01 in the proleptic Gregorian calendar.
+    sql::int32 days_since_epoch (const ::SQL_DATE_STRUCT& date)
+    {
+        const int year = date.year - ((date.month <= 2)? 1 : 0);
+        const int era = ((year >= 0)? year : year-399) / 400;
+        const int yoe = year - era*400;
+        const int month = date.month;
+        const int doy = (153*((month > 2)? month-3 : month+9) + 2)/5
+            + date.day-1;
+        const int doe = yoe*365 + yoe/4 - yoe/100 + doy;
+        return (era*146097 + doe - 719468);
+    }
+
+    template<typename T>
+    T * elements (std::vector<char>& data, std::size_t count)
+    {
+        data.resize(count*sizeof(T));
+        return (reinterpret_cast<T*>(data.empty()? 0 : &data[0]));
+    }
+
+    template<typename T>
+    const T * elements (const std::vector<char>& data)
+    {
+        return (reinterpret_cast<const T*>(data.empty()? 0 : &data[0]));
+    }
+
+    // Convert values that do not already use the Arrow representation.
+    void convert (const sql::Batch::Column& column,
+                  std::vector<char>& data, std::size_t rows)
+    {
+        std::vector<char> values;
+        values.swap(data);
+        if (column.is_date())
+        {
+            const ::SQL_DATE_STRUCT *const dates =
+                elements< ::SQL_DATE_STRUCT >(values);
+            sql::int32 *const days = elements<sql::int32>(data, rows);
+            for (std::size_t i = 0; (i < rows); ++i) {
+                days[i] = days_since_epoch(dates[i]);
+            }
+        }
+        else if (column.is_time())
+        {
+            const ::SQL_TIME_STRUCT *const times =
+                elements< ::SQL_TIME_STRUCT >(values);
+            sql::int32 *const seconds = elements<sql::int32>(data, rows);
+            for (std::size_t i = 0; (i < rows); ++i) {
+                seconds[i] = times[i].hour*3600
+                    + times[i].minute*60 + times[i].second;
+            }
+        }
+        else if (column.is_timestamp())
+        {
+            const ::SQL_TIMESTAMP_STRUCT *const timestamps =
+                elements< ::SQL_TIMESTAMP_STRUCT >(values);
+            sql::int64 *const nanoseconds = elements<sql::int64>(data, rows);
+            for (std::size_t i = 0; (i < rows); ++i)
+            {
+                const ::SQL_TIMESTAMP_STRUCT& timestamp = timestamps[i];
+                ::SQL_DATE_STRUCT date;
+                date.year = timestamp.year;
+                date.month = timestamp.month;
+                date.day = timestamp.day;
+                const sql::int64 seconds =
+                    sql::int64(days_since_epoch(date))*86400
+                    + timestamp.hour*3600 + timestamp.minute*60
+                    + timestamp.second;
+                nanoseconds[i] = seconds*1000000000 + timestamp.fraction;
+            }
+        }
+        else if (column.is_guid())
+        {
+                // Integer fields are stored in native byte order.
+            const ::SQLGUID *const guids = elements< ::SQLGUID >(values);
+            unsigned char *const bytes =
+                elements<unsigned char>(data, 16*rows);
+            for (std::size_t i = 0; (i < rows); ++i)
+            {
+                const ::SQLGUID& guid = guids[i];
+                unsigned char *const value = bytes + 16*i;
+                for (int j = 0; (j < 4); ++j) {
+                    value[j] = (guid.Data1 >> (24-8*j)) & 0xff;
+                }
+                value[4] = (guid.Data2 >> 8) & 0xff;
+                value[5] = guid.Data2 & 0xff;
+                value[6] = (guid.Data3 >> 8) & 0xff;
+                value[7] = guid.Data3 & 0xff;
+                std::memcpy(value+8, guid.Data4, 8);
+            }
+        }
+        else if (column.is_numeric())
+        {
+                // Sign and magnitude to little endian two's complement.
+            const ::SQL_NUMERIC_STRUCT *const numerics =
+                elements< ::SQL_NUMERIC_STRUCT >(values);
+            unsigned char *const bytes =
+                elements<unsigned char>(data, 16*rows);
+            for (std::size_t i = 0; (i < rows); ++i)
+            {
+                const ::SQL_NUMERIC_STRUCT& numeric = numerics[i];
+                unsigned char *const value = bytes + 16*i;
+                std::memcpy(value, numeric.val, 16);
+                if (numeric.sign == 0)
+                {
+                    unsigned int carry = 1;
+                    for (int j = 0; (j < 16); ++j)
+                    {
+                        carry += static_cast<unsigned char>(~value[j]);
+                        value[j] = static_cast<unsigned char>(carry & 0xff);
+                        carry >>= 8;
+                    }
+                }
+            }
+        }
+        else {
+            values.swap(data);
+        }
+    }
+
+    const void * buffer (const std::vector<char>& data)
+    {
+        static const sql::int64 empty = 0;
+        return (data.empty()? &empty : static_cast<const void*>(&data[0]));
+    }
+
+}
+
+namespace sql { namespace arrow {
+
+    void export_schema (const Batch& batch, ::ArrowSchema * schema)
+    {
+        Schema *const owner = new Schema();
+        owner->format = "+s";
+        for (size_t i = 0; (i < batch.columns()); ++i)
+        {
+            const Batch::Column& column = batch.column(i);
+            Schema *const data = new Schema();
+            data->format = ::format(column);
+            data->name = column.name().c_str();
+            ::ArrowSchema *const child = new ::ArrowSchema();
+            child->format = data->format.c_str();
+            child->name = data->name.c_str();
+            child->metadata = 0;
+            child->flags = ARROW_FLAG_NULLABLE;
+            child->n_children = 0;
+            child->children = 0;
+            child->dictionary = 0;
+            child->release = &::release_schema;
+            child->private_data = data;
+            owner->children.push_back(child);
+        }
+        schema->format = owner->format.c_str();
+        schema->name = "";
+        schema->metadata = 0;
+        schema->flags = 0;
+        schema->n_children = owner->children.size();
+        schema->children = owner->children.empty()? 0 : &owner->children[0];
+        schema->dictionary = 0;
+        schema->release = &::release_schema;
+        schema->private_data = owner;
+    }
+
+    void export_array (Batch& batch, ::ArrowArray * array)
+    {
+        const std::size_t rows = batch.rows();
+        Array *const owner = new Array();
+        owner->buffers.push_back(0);
+        for (size_t i = 0; (i < batch.columns()); ++i)
+        {
+            Batch::Column& column = batch.column(i);
+            Array *const data = new Array();
+            const size_t nulls = column.null_count();
+            column.swap(data->data, data->offsets, data->validity);
+            ::convert(column, data->data, rows);
+
+            data->buffers.push_back(
+                (nulls == 0)? 0 : static_cast<const void*>(&data->validity[0])
+                );
+            if (column.is_string())
+            {
+                if (data->offsets.empty()) {
+                    data->offsets.push_back(0);
+                }
+                data->buffers.push_back(&data->offsets[0]);
+            }
+            data->buffers.push_back(::buffer(data->data));
+
+            ::ArrowArray *const child = new ::ArrowArray();
+            child->length = rows;
+            child->null_count = nulls;
+            child->offset = 0;
+            child->n_buffers = data->buffers.size();
+            child->n_children = 0;
+            child->buffers = &data->buffers[0];
+            child->children = 0;
+            child->dictionary = 0;
+            child->release = &::release_array;
+            child->private_data = data;
+            owner->children.push_back(child);
+        }
+        array->length = rows;
+        array->null_count = 0;
+        array->offset = 0;
+        array->n_buffers = owner->buffers.size();
+        array->n_children = owner->children.size();
+        array->buffers = &owner->buffers[0];
+        array->children = owner->children.empty()? 0 : &owner->children[0];
+        array->dictionary = 0;
+        array->release = &::release_array;
+        array->private_data = owner;
+    }
+
+} }
@@ -0,0 +1,145 @@
+#ifndef _sql_arrow_hpp__
+#define _sql_arrow_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*!
+ * @file arrow.hpp
+ * @brief sqlxx Apache Arrow C data interface support.
+ *
+ * @see sql::arrow
+ */
+
+#include "Batch.hpp"
+#include <stdint.h>
+
+// Apache Arrow C data interface, as specified in
+// <https://arrow.apache.org/docs/format/CDataInterface.html>.  These
+// definitions are part of a stable ABI and may be provided by other
+// libraries, in which case the guard prevents redefinition.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+}
+
+#endif /* ARROW_C_DATA_INTERFACE */
+
+namespace sql {
+
+    /*!
+     * @brief Support for the Apache Arrow C data interface.
+     *
+     * Batches are exported as Arrow struct arrays, with one child array per
+     * column.  Column types map to Arrow types as follows:
+     * - @c int8, @c int16, @c int32, @c int64: signed integers;
+     * - @c float, @c double: floating point values;
+     * - strings: @c utf8 (the driver's character encoding is not converted);
+     * - @c Date: @c date32, days since the UNIX epoch;
+     * - @c Time: @c time32, seconds since midnight;
+     * - @c Timestamp: @c timestamp, nanoseconds since the UNIX epoch, no
+     *   time zone;
+     * - @c Guid: 16 byte fixed size binary, in RFC 4122 byte order;
+     * - @c Numeric: @c decimal128 with the column's precision and scale.
+     *
+     * No Arrow library is required.
+     *
+     * @see sql.hpp
+     * @see arrow.hpp
+     * @see http://arrow.apache.org/
+     */
+    namespace arrow {}
+
+}
+
+namespace sql { namespace arrow {
+
+    /*!
+     * @brief Describe the columns of @a batch.
+     * @param batch Batch whose columns to describe.
+     * @param schema Receives the Arrow schema for a struct array.  The
+     *  caller is responsible for calling @c schema->release.
+     */
+    void export_schema (const Batch& batch, ::ArrowSchema * schema);
+
+    /*!
+     * @brief Hand over the rows of @a batch.
+     * @param batch Batch whose rows to export.
+     * @param array Receives the Arrow struct array.  The caller is
+     *  responsible for calling @c array->release.
+     *
+     * Buffers that already use the Arrow layout (integers, floating point
+     * values, strings and validity bitmaps) are moved into @a array without
+     * being copied.  The batch's columns are left empty until its next
+     * @c Batch::fetch().
+     *
+     * Typical use looks like:
+     * @code
+     *  sql::Results results(statement);
+     *  sql::Batch batch(65536);
+     *  while (results >> batch) {
+     *    ::ArrowArray array;
+     *    sql::arrow::export_array(batch, &array);
+     *    consume(&array);
+     *  }
+     * @endcode
+     */
+    void export_array (Batch& batch, ::ArrowArray * array);
+
+} }
+
+#endif /* _sql_arrow_hpp__ */
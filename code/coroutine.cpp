@@ -0,0 +1,172 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "coroutine.hpp"
+
+#if (defined(SQLXX_COROUTINES))
+
+#include <algorithm>
+#include <chrono>
+
+namespace sql { namespace async {
+
+    Pool& Pool::shared ()
+    {
+        static Pool pool(std::max(2u, std::thread::hardware_concurrency()));
+        return (pool);
+    }
+
+    Pool::Pool (std::size_t threads)
+        : myMutex(), myReady(), myJobs(), myThreads(), myStopping(false)
+    {
+        for (std::size_t i = 0; (i < threads); ++i) {
+            myThreads.push_back(std::thread(&Pool::run, this));
+        }
+    }
+
+    Pool::~Pool ()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(myMutex);
+            myStopping = true;
+        }
+        myReady.notify_all();
+        for (std::size_t i = 0; (i < myThreads.size()); ++i) {
+            myThreads[i].join();
+        }
+    }
+
+    void Pool::submit (Job job)
+    {
+        {
+            const std::lock_guard<std::mutex> lock(myMutex);
+            myJobs.push_back(std::move(job));
+        }
+        myReady.notify_one();
+    }
+
+    void Pool::run ()
+    {
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(myMutex);
+                myReady.wait(lock, [this] () {
+                    return (myStopping || !myJobs.empty());
+                });
+                if (myJobs.empty()) {
+                    return;
+                }
+                job = std::move(myJobs.front());
+                myJobs.pop_front();
+            }
+            if (!job())
+            {
+                    // Still executing: give the driver some time.
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                submit(std::move(job));
+            }
+        }
+    }
+
+    bool Execute::await_ready ()
+    {
+            // Complete right away when the driver does so.
+        myNative = myStatement.asynchronous(true);
+        if (!myNative) {
+            return (false);
+        }
+        try {
+            if (!myStatement.start()) {
+                return (false);
+            }
+        }
+        catch ( ... ) {
+            myError = std::current_exception();
+        }
+        myStatement.asynchronous(false);
+        return (true);
+    }
+
+    void Execute::await_suspend (std::coroutine_handle<> coroutine)
+    {
+        Pool::shared().submit([this, coroutine] ()
+        {
+            if (!step()) {
+                return (false);
+            }
+            coroutine.resume();
+            return (true);
+        });
+    }
+
+    Statement& Execute::await_resume ()
+    {
+        if (myError) {
+            std::rethrow_exception(myError);
+        }
+        return (myStatement);
+    }
+
+    bool Execute::step ()
+    {
+        try {
+            if (!myNative) {
+                myStatement.execute();
+            }
+            else if (!myStatement.poll()) {
+                return (false);
+            }
+        }
+        catch ( ... ) {
+            myError = std::current_exception();
+        }
+        if (myNative) {
+            myStatement.asynchronous(false);
+        }
+        return (true);
+    }
+
+    Blocking< std::unique_ptr<PreparedStatement> >
+        prepare (Connection& connection, const string& text)
+    {
+        return (Blocking< std::unique_ptr<PreparedStatement> >(
+            [&connection, text] ()
+        {
+            return (std::unique_ptr<PreparedStatement>(
+                new PreparedStatement(connection, text)));
+        }));
+    }
+
+    Execute execute (Statement& statement)
+    {
+        return (Execute(statement));
+    }
+
+} }
+
+#endif
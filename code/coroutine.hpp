@@ -0,0 +1,250 @@
+#ifndef _sql_coroutine_hpp__
+#define _sql_coroutine_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+
+#if (defined(SQLXX_COROUTINES))
+
+#include "types.hpp"
+#include "string.hpp"
+#include "Connection.hpp"
+#include "NotCopyable.hpp"
+#include "PreparedStatement.hpp"
+#include "Rows.hpp"
+#include "Statement.hpp"
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ * @brief Awaitable operations, for C++20 coroutines.
+ *
+ * Awaiting an operation suspends the coroutine instead of blocking its
+ * thread.  Statements are executed asynchronously when the driver supports
+ * it, and a bounded pool of threads polls them.  Otherwise, the pool's
+ * threads perform the operation.  The coroutine is resumed on one of the
+ * pool's threads.
+ *
+ * These work with any coroutine type, such as the @c Task of a service
+ * framework:
+ *
+ * @code
+ *  Task query (sql::Connection& connection)
+ *  {
+ *    std::unique_ptr<sql::PreparedStatement> statement =
+ *        co_await sql::async::prepare(connection, "select id from t;");
+ *    co_await sql::async::execute(*statement);
+ *    sql::Results results(*statement);
+ *    sql::Rows<sql::int32> rows = results.as<sql::int32>();
+ *    std::vector< std::tuple<sql::int32> > batch;
+ *    while (co_await sql::async::fetch(rows, batch, 100) > 0) {
+ *      // ...
+ *    }
+ *  }
+ * @endcode
+ */
+namespace sql { namespace async {
+
+    /*!
+     * @brief Bounded pool of threads that completes awaited operations.
+     */
+    class Pool :
+        private NotCopyable
+    {
+        /* nested types. */
+    public:
+        /*!
+         * @brief Unit of work, called until it returns @c true.
+         */
+        typedef std::function<bool()> Job;
+
+        /* class methods. */
+    public:
+        /*!
+         * @brief Pool used by awaitable operations.
+         */
+        static Pool& shared ();
+
+        /* data. */
+    private:
+        std::mutex myMutex;
+        std::condition_variable myReady;
+        std::deque<Job> myJobs;
+        std::vector<std::thread> myThreads;
+        bool myStopping;
+
+        /* construction. */
+    public:
+        /*!
+         * @brief Start @a threads threads.
+         */
+        explicit Pool (std::size_t threads);
+
+        /*!
+         * @brief Finish queued jobs, then stop the threads.
+         */
+        ~Pool ();
+
+        /* methods. */
+    public:
+        /*!
+         * @brief Queue @a job, which is called until it returns @c true.
+         *
+         * Jobs that return @c false (e.g. polling a statement that is still
+         * executing) are queued again after a short delay.
+         */
+        void submit (Job job);
+
+    private:
+        void run ();
+    };
+
+    /*!
+     * @internal
+     * @brief Operation performed by the pool's threads.
+     */
+    template<typename T>
+    class Blocking
+    {
+        /* data. */
+    private:
+        std::function<T()> myWork;
+        T myValue;
+        std::exception_ptr myError;
+
+        /* construction. */
+    public:
+        explicit Blocking (std::function<T()> work)
+            : myWork(std::move(work)), myValue(), myError()
+        {}
+
+        /* methods. */
+    public:
+        bool await_ready () const {
+            return (false);
+        }
+
+        void await_suspend (std::coroutine_handle<> coroutine)
+        {
+            Pool::shared().submit([this, coroutine] ()
+            {
+                try {
+                    myValue = myWork();
+                }
+                catch ( ... ) {
+                    myError = std::current_exception();
+                }
+                coroutine.resume();
+                return (true);
+            });
+        }
+
+        T await_resume ()
+        {
+            if (myError) {
+                std::rethrow_exception(myError);
+            }
+            return (std::move(myValue));
+        }
+    };
+
+    /*!
+     * @internal
+     * @brief Statement execution, polled by the pool's threads.
+     */
+    class Execute
+    {
+        /* data. */
+    private:
+        Statement& myStatement;
+        bool myNative;
+        std::exception_ptr myError;
+
+        /* construction. */
+    public:
+        explicit Execute (Statement& statement)
+            : myStatement(statement), myNative(false), myError()
+        {}
+
+        /* methods. */
+    public:
+        bool await_ready ();
+        void await_suspend (std::coroutine_handle<> coroutine);
+        Statement& await_resume ();
+
+    private:
+        bool step ();
+    };
+
+    /*!
+     * @brief Prepare a statement.
+     * @return The prepared statement.
+     */
+    Blocking< std::unique_ptr<PreparedStatement> >
+        prepare (Connection& connection, const string& text);
+
+    /*!
+     * @brief Execute a statement, suspending until it completes.
+     * @return The statement, once executed.
+     */
+    Execute execute (Statement& statement);
+
+    /*!
+     * @brief Read the next batch of rows.
+     * @param rows Result set reader.
+     * @param batch Receives at most @a count rows, replacing its contents.
+     * @param count Maximum number of rows to read.
+     * @return The number of rows read, 0 at the end of the result set.
+     */
+    template<typename Row, typename... Types>
+    Blocking<size_t> fetch (Rows<Types...>& rows,
+                            std::vector<Row>& batch, size_t count)
+    {
+        return (Blocking<size_t>([&rows, &batch, count] ()
+        {
+            batch.clear();
+            Row row;
+            while ((size_t(batch.size()) < count) && (rows >> row)) {
+                batch.push_back(row);
+            }
+            return (size_t(batch.size()));
+        }));
+    }
+
+} }
+
+#endif
+
+#endif /* _sql_coroutine_hpp__ */
@@ -0,0 +1,115 @@
+#ifndef _sql_query_hpp__
+#define _sql_query_hpp__
+
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "__configure__.hpp"
+#include "types.hpp"
+#include "PreparedStatement.hpp"
+#include "Results.hpp"
+#include "Rows.hpp"
+#include <tuple>
+#include <vector>
+
+namespace sql {
+
+    /*!
+     * @brief Column types of a row read by @c query().
+     *
+     * Tuples need nothing more.  Other row types, such as structures, must
+     * list their column types, in order, as a tuple:
+     *
+     * @code
+     *  namespace sql {
+     *    template<> struct row_traits<Entry> {
+     *      typedef std::tuple<sql::int32, sql::string, double> columns;
+     *    };
+     *  }
+     * @endcode
+     */
+    template<typename Row> struct row_traits;
+
+    template<typename... Types>
+    struct row_traits< std::tuple<Types...> >
+    {
+        typedef std::tuple<Types...> columns;
+    };
+
+    /*!
+     * @internal
+     * @brief Read all rows using the column types in @a Columns.
+     */
+    template<typename Row, typename Columns> struct row_reader;
+
+    template<typename Row, typename... Types>
+    struct row_reader< Row, std::tuple<Types...> >
+    {
+        static void read (Results& results, std::vector<Row>& rows)
+        {
+            Rows<Types...> reader = results.as<Types...>();
+            Row row;
+            while (reader >> row) {
+                rows.push_back(row);
+            }
+        }
+    };
+
+    /*!
+     * @brief Bind one value per parameter, send the query and read all rows.
+     * @param statement Prepared statement.
+     * @param args Parameter values, in order.
+     * @return All rows of the result set.
+     * @throw std::invalid_argument The number of values does not match the
+     *  number of parameters.
+     * @throw Diagnostic The query or one of the fetches failed.
+     *
+     * Rows are fetched in blocks, as by @c Results::as().  The returned
+     * rows are always the complete result set: errors are never reported
+     * as a shorter one.
+     *
+     * @code
+     *  typedef std::tuple<sql::int32, sql::string> Entry;
+     *  const std::vector<Entry> entries =
+     *      sql::query<Entry>(statement, sql::int32(10));
+     * @endcode
+     *
+     * @see execute(PreparedStatement&,const Arg&,const Args&...)
+     */
+    template<typename Row, typename... Args>
+    std::vector<Row> query (PreparedStatement& statement, const Args&... args)
+    {
+        execute(statement, args...);
+        Results results(statement);
+        std::vector<Row> rows;
+        row_reader<Row, typename row_traits<Row>::columns>::read(
+            results, rows);
+        return (rows);
+    }
+
+}
+
+#endif /* _sql_query_hpp__ */
@@ -28,6 +28,7 @@
  * @file sql.hpp
  * @brief sqlxx library header.
  *
+ * @see arrow.hpp
  * @see firebird.hpp
  * @see mysql.hpp
  * @see odbc.hpp
@@ -0,0 +1,179 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    // Allocated but never connected: enough to exercise the pool.
+    class Idle :
+        public sql::Connection
+    {
+    public:
+        explicit Idle (sql::Environment& environment)
+            : sql::Connection(environment)
+        {}
+    };
+
+    void affinity (sql::Environment& environment)
+    {
+        std::cerr << "Reusing the thread's connection." << std::endl;
+        sql::ConnectionPool pool([&] () -> sql::Connection* {
+            return (new Idle(environment));
+        }, 0, 2);
+        pool.validate_after(3600);
+        sql::AffinityPool cache(pool);
+        sql::Connection * first = 0;
+        {
+            sql::AffinityPool::Lease lease = cache.acquire();
+            first = &lease.connection();
+        }
+        assert((pool.size() == 1) && (pool.idle() == 0));
+        {
+            sql::AffinityPool::Lease lease = cache.acquire();
+            assert(&lease.connection() == first);
+        }
+        {
+            sql::AffinityPool::Lease lease = cache.acquire();
+            lease.discard();
+        }
+        assert((pool.size() == 0) && (pool.idle() == 0));
+    }
+
+    void stealing (sql::Environment& environment)
+    {
+        std::cerr << "Stealing from other threads." << std::endl;
+        sql::ConnectionPool pool([&] () -> sql::Connection* {
+            return (new Idle(environment));
+        }, 0, 1);
+        pool.validate_after(3600);
+        sql::AffinityPool cache(pool);
+        std::thread([&cache] () {
+            sql::AffinityPool::Lease lease = cache.acquire();
+        }).join();
+        sql::AffinityPool::Lease lease;
+        assert(cache.try_acquire(lease) && lease.valid());
+        assert(pool.size() == 1);
+    }
+
+    void turnover (sql::Environment& environment)
+    {
+        std::cerr << "Reclaiming caches of exited threads." << std::endl;
+        sql::ConnectionPool pool([&] () -> sql::Connection* {
+            return (new Idle(environment));
+        }, 0, 1);
+        pool.validate_after(3600);
+            // A single cache, which each thread inherits in turn.
+        sql::AffinityPool cache(pool, 1, 1);
+        sql::Connection * first = 0;
+        for (int i = 0; (i < 8); ++i)
+        {
+            std::thread([&cache, &first] () {
+                sql::AffinityPool::Lease lease = cache.acquire();
+                assert((first == 0) || (&lease.connection() == first));
+                first = &lease.connection();
+            }).join();
+        }
+        assert((pool.size() == 1) && (pool.idle() == 0));
+    }
+
+    void waiting (sql::Environment& environment)
+    {
+        std::cerr << "Waiting for a cached connection." << std::endl;
+        sql::ConnectionPool pool([&] () -> sql::Connection* {
+            return (new Idle(environment));
+        }, 0, 1);
+        pool.validate_after(3600);
+        sql::AffinityPool cache(pool);
+        sql::AffinityPool::Lease lease = cache.acquire();
+        std::thread other([&lease] () {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            lease.release();
+        });
+        sql::AffinityPool::Lease next = cache.acquire();
+        other.join();
+        assert(next.valid() && (pool.size() == 1));
+    }
+
+    void contention (sql::Environment& environment)
+    {
+        std::cerr << "Sharing few connections." << std::endl;
+        sql::ConnectionPool pool([&] () -> sql::Connection* {
+            return (new Idle(environment));
+        }, 0, 2);
+        pool.validate_after(3600);
+        sql::AffinityPool cache(pool, 1, 4);
+        std::atomic<int> leased(0);
+        std::atomic<int> peak(0);
+        std::vector<std::thread> threads;
+        for (int i = 0; (i < 8); ++i)
+        {
+            threads.push_back(std::thread([&] () {
+                for (int j = 0; (j < 200); ++j)
+                {
+                    sql::AffinityPool::Lease lease = cache.acquire();
+                    const int now = ++leased;
+                    int seen = peak.load();
+                    while ((now > seen) &&
+                           !peak.compare_exchange_weak(seen, now))
+                        ;
+                    --leased;
+                }
+            }));
+        }
+        for (std::size_t i = 0; (i < threads.size()); ++i) {
+            threads[i].join();
+        }
+        assert((peak.load() <= 2) && (pool.size() <= 2));
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        sql::Environment environment;
+        affinity(environment);
+        stealing(environment);
+        turnover(environment);
+        waiting(environment);
+        contention(environment);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
@@ -0,0 +1,231 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+#include "arrow.hpp"
+#include <cstring>
+#include <sstream>
+#include <string>
+
+namespace {
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table entries ( id integer, name varchar(32),"
+            " day date, moment time, stamp timestamp,"
+            " amount numeric(10,2), tag uniqueidentifier );");
+        sql::execute(connection,
+            "insert into entries values (1, 'a', '1970-01-02', '01:02:03',"
+            " '1970-01-01 00:00:01', 12.34,"
+            " '00112233-4455-6677-8899-aabbccddeeff');");
+        sql::execute(connection,
+            "insert into entries values (2, null, '1969-12-31', '00:00:00',"
+            " '1969-12-31 23:59:59', -12.34, null);");
+        sql::execute(connection,
+            "insert into entries values (3, 'ccc', '1900-03-01', '23:59:59',"
+            " '2000-01-01 00:00:00', 0, "
+            " '00112233-4455-6677-8899-aabbccddeeff');");
+    }
+
+    template<typename T>
+    const T * values (const ::ArrowArray * array)
+    {
+        return (static_cast<const T*>(array->buffers[1]));
+    }
+
+    void schema (const sql::Batch& batch)
+    {
+        std::cerr << "Exporting the schema." << std::endl;
+        ::ArrowSchema schema;
+        sql::arrow::export_schema(batch, &schema);
+        assert(std::strcmp(schema.format, "+s") == 0);
+        assert(schema.n_children == 7);
+        const char *const formats[] = { "i", "u", "tdD", "tts", "tsn:" };
+        for (int i = 0; (i < 5); ++i) {
+            assert(std::strcmp(schema.children[i]->format, formats[i]) == 0);
+        }
+        assert(std::strcmp(schema.children[0]->name, "id") == 0);
+        assert(schema.children[1]->flags == ARROW_FLAG_NULLABLE);
+
+            // Some drivers report these as double and string.
+        const sql::Batch::Column& amount = batch.column(5);
+        if (amount.is_numeric())
+        {
+            std::ostringstream format;
+            format << "d:" << amount.precision() << ',' << amount.scale();
+            assert(schema.children[5]->format == format.str());
+        }
+        if (batch.column(6).is_guid()) {
+            assert(std::strcmp(schema.children[6]->format, "w:16") == 0);
+        }
+
+        schema.release(&schema);
+        assert(schema.release == 0);
+    }
+
+    void strings (const ::ArrowArray * name)
+    {
+        assert((name->n_buffers == 3) && (name->null_count == 1));
+        const sql::uint8 *const validity =
+            static_cast<const sql::uint8*>(name->buffers[0]);
+        assert((validity != 0) && ((validity[0] & 7) == 5));
+        const sql::int32 *const offsets =
+            static_cast<const sql::int32*>(name->buffers[1]);
+        const char *const characters =
+            static_cast<const char*>(name->buffers[2]);
+        assert((offsets[0] == 0) && (offsets[1] == 1));
+        assert(std::string(characters+offsets[0], characters+offsets[1])
+               == "a");
+        assert(std::string(characters+offsets[2], characters+offsets[3])
+               == "ccc");
+    }
+
+    void numbers (const sql::Batch& batch, const ::ArrowArray * amount)
+    {
+        if (!batch.column(5).is_numeric()) {
+            std::cerr << "  (driver does not report numeric)" << std::endl;
+            return;
+        }
+        assert(amount->buffers[0] == 0);
+        const unsigned char *const values =
+            static_cast<const unsigned char*>(amount->buffers[1]);
+        const int scale = batch.column(5).scale();
+        sql::int64 expected = 1234;
+        for (int i = 2; (i < scale); ++i) {
+            expected *= 10;
+        }
+
+            // Little endian two's complement: 12.34, -12.34 and 0.
+        const sql::int64 signs[] = { 1, -1, 0 };
+        for (int row = 0; (row < 3); ++row)
+        {
+            const unsigned char *const value = values + 16*row;
+            const sql::int64 unscaled = signs[row]*expected;
+            for (int j = 0; (j < 16); ++j)
+            {
+                const unsigned char byte = (j < 8)?
+                    static_cast<unsigned char>(
+                        static_cast<sql::uint64>(unscaled) >> (8*j)) :
+                    ((unscaled < 0)? 0xff : 0x00);
+                assert(value[j] == byte);
+            }
+        }
+    }
+
+    void guids (const sql::Batch& batch, const ::ArrowArray * tag)
+    {
+        if (!batch.column(6).is_guid()) {
+            std::cerr << "  (driver does not report GUIDs)" << std::endl;
+            return;
+        }
+        assert(tag->null_count == 1);
+        const unsigned char *const values =
+            static_cast<const unsigned char*>(tag->buffers[1]);
+        for (int j = 0; (j < 16); ++j) {
+            assert(values[j] == 0x11*j);
+            assert(values[32+j] == 0x11*j);
+        }
+    }
+
+    void array (sql::Batch& batch)
+    {
+        std::cerr << "Exporting the rows." << std::endl;
+        ::ArrowArray array;
+        sql::arrow::export_array(batch, &array);
+        assert((array.length == 3) && (array.n_children == 7));
+        assert((array.n_buffers == 1) && (array.buffers[0] == 0));
+        for (int i = 0; (i < 7); ++i) {
+            assert(array.children[i]->length == 3);
+            assert(array.children[i]->release != 0);
+        }
+
+        const ::ArrowArray *const id = array.children[0];
+        assert((id->n_buffers == 2) && (id->buffers[0] == 0));
+        assert((id->null_count == 0) && (values<sql::int32>(id)[2] == 3));
+
+        strings(array.children[1]);
+
+            // Days since the epoch, including dates before 1970.
+        const sql::int32 *const days = values<sql::int32>(array.children[2]);
+        assert((days[0] == 1) && (days[1] == -1) && (days[2] == -25508));
+
+        const sql::int32 *const seconds =
+            values<sql::int32>(array.children[3]);
+        assert((seconds[0] == 3723) && (seconds[1] == 0));
+        assert(seconds[2] == 86399);
+
+        const sql::int64 *const stamps = values<sql::int64>(array.children[4]);
+        assert(stamps[0] == 1000000000);
+        assert(stamps[1] == -1000000000);
+        assert(stamps[2] == sql::int64(946684800)*1000000000);
+
+        numbers(batch, array.children[5]);
+        guids(batch, array.children[6]);
+
+            // The buffers now belong to the array.
+        assert(batch.column(0).values<sql::int32>() == 0);
+
+        array.release(&array);
+        assert(array.release == 0);
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table entries;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        {
+            sql::PreparedStatement statement(connection,
+                "select id, name, day, moment, stamp, amount, tag"
+                " from entries order by id;");
+            sql::Results results(statement<<sql::execute);
+            sql::Batch batch(16);
+            assert(results >> batch);
+            assert((batch.rows() == 3) && (batch.columns() == 7));
+            schema(batch);
+            array(batch);
+        }
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
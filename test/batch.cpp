@@ -0,0 +1,165 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+
+namespace {
+
+    const sql::int32 count = 10;
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table entries ( id integer, name varchar(32), ratio double );");
+        sql::PreparedStatement statement(connection,
+            "insert into entries ( id, name, ratio ) values (?, ?, ?);");
+        for ( sql::int32 i = 0; (i < count); ++i )
+        {
+            const sql::string name(std::string(i+1, 'x'));
+            if ((i % 3) == 0) {
+                statement << i << name << sql::null << sql::execute;
+            }
+            else {
+                statement << i << name << (i * 0.5) << sql::execute;
+            }
+        }
+    }
+
+    void select (sql::Connection& connection, sql::size_t capacity)
+    {
+        std::cerr << "Reading batches of " << capacity << " rows." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "select id, name, ratio from entries order by id;");
+        sql::Results results(statement<<sql::execute);
+        sql::Batch batch(capacity);
+        sql::int32 i = 0;
+        while (results >> batch)
+        {
+            assert(batch.columns() == 3);
+            assert(batch.rows() <= capacity);
+            const sql::Batch::Column& ids = batch.column(0);
+            const sql::Batch::Column& names = batch.column(1);
+            const sql::Batch::Column& ratios = batch.column(2);
+            assert(ids.is_int32() && names.is_string() && ratios.is_double());
+            for (sql::size_t row = 0; (row < batch.rows()); ++row, ++i)
+            {
+                assert(!ids.null(row) && (ids.values<sql::int32>()[row] == i));
+                const sql::int32 * offsets = names.offsets();
+                assert((offsets[row+1]-offsets[row]) == i+1);
+                assert(ratios.null(row) == ((i % 3) == 0));
+                assert(ratios.null(row) ||
+                       (ratios.values<double>()[row] == i * 0.5));
+            }
+        }
+        assert(i == count);
+    }
+
+    void reuse (sql::Connection& connection)
+    {
+        std::cerr << "Reusing a batch for another query." << std::endl;
+        sql::Batch batch(4*count);
+        {
+            sql::PreparedStatement statement(connection,
+                "select id from entries order by id;");
+            sql::Results results(statement<<sql::execute);
+            assert(results >> batch);
+            assert((batch.columns() == 1) && batch.column(0).is_int32());
+        }
+
+            // Likely gets the same statement handle back.
+        sql::PreparedStatement statement(connection,
+            "select ratio, name from entries where ratio is not null"
+            " order by id;");
+        sql::Results results(statement<<sql::execute);
+        assert(results >> batch);
+        assert((batch.columns() == 2) && batch.column(0).is_double());
+        assert(batch.column(1).is_string());
+        assert(batch.column(0).values<double>()[0] == 0.5);
+    }
+
+    void overflow (sql::Connection& connection)
+    {
+        std::cerr << "Reading values longer than their column." << std::endl;
+            // The declared size is only a hint for some drivers (SQLite).
+        const std::string text(100, 'y');
+        sql::execute(connection,
+            "create table overflow ( id integer, name varchar(8) );");
+        sql::PreparedStatement insert(connection,
+            "insert into overflow ( id, name ) values (?, ?);");
+        for ( sql::int32 i = 0; (i < count); ++i )
+        {
+            const std::string name((i % 2) == 0? text : std::string(3, 'z'));
+            insert << i << sql::string(name) << sql::execute;
+        }
+        sql::PreparedStatement statement(connection,
+            "select id, name from overflow order by id;");
+        sql::Results results(statement<<sql::execute);
+        sql::Batch batch(4);
+        sql::int32 i = 0;
+        while (results >> batch)
+        {
+            const sql::Batch::Column& names = batch.column(1);
+            const sql::int32 * offsets = names.offsets();
+            for (sql::size_t row = 0; (row < batch.rows()); ++row, ++i)
+            {
+                const sql::int32 length = offsets[row+1]-offsets[row];
+                assert(length == ((i % 2) == 0? 100 : 3));
+            }
+        }
+        assert(i == count);
+        sql::execute(connection, "drop table overflow;");
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table entries;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        select(connection, 1);
+        select(connection, 4);
+        select(connection, 4*count);
+        reuse(connection);
+        overflow(connection);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
@@ -0,0 +1,149 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+
+namespace {
+
+    const sql::int32 count = 10;
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table entries ( id integer, name varchar(32), ratio double );");
+        sql::PreparedStatement statement(connection,
+            "insert into entries ( id, name, ratio ) values (?, ?, ?);");
+        for ( sql::int32 i = 0; (i < count); ++i )
+        {
+            const sql::string name(std::string(i+1, 'x'));
+            const double ratio = i * 0.5;
+            statement << i << name << ratio << sql::execute;
+        }
+    }
+
+    void select (sql::Connection& connection, sql::size_t rows)
+    {
+        std::cerr << "Fetching " << rows << " rows at a time." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "select id, name, ratio from entries order by id;");
+        sql::Results results(statement<<sql::execute);
+        results.fetch_size(rows).bind_strings(true);
+        sql::int32 i = 0;
+        for ( ; (results >> sql::row); ++i )
+        {
+            sql::int32 id = -1;
+            sql::string name;
+            double ratio = -1.0;
+            assert(results >> id >> name >> ratio);
+            assert(id == i);
+            assert(name.length() == i+1);
+            assert(ratio == i * 0.5);
+        }
+        assert(i == count);
+    }
+
+    void mismatch (sql::Connection& connection)
+    {
+        std::cerr << "Reading a skipped column." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "select id, name, ratio from entries order by id;");
+        sql::Results results(statement<<sql::execute);
+        sql::int32 id = -1;
+        sql::string name;
+        double ratio = -1.0;
+        assert(results >> sql::row);
+        assert(results >> sql::skip >> name >> ratio);
+        assert(name.length() == 1);
+        assert(results >> sql::row);
+        assert(results >> id >> name >> ratio);
+        assert((id == 1) && (name.length() == 2) && (ratio == 0.5));
+        assert(results >> sql::row);
+        assert(results >> id >> name);
+        assert((id == 2) && (name.length() == 3));
+    }
+
+    void overflow (sql::Connection& connection, bool bound, sql::size_t rows)
+    {
+        std::cerr
+            << "Reading values longer than declared ("
+            << (bound? "bound" : "unbound") << ")." << std::endl;
+        sql::execute(connection, "create table short ( name varchar(4) );");
+        sql::PreparedStatement insert(connection,
+            "insert into short ( name ) values (?);");
+        const sql::string longer("far longer than four characters");
+        insert << sql::string("abc") << sql::execute;
+        insert << longer << sql::execute;
+        insert << sql::string("def") << sql::execute;
+        {
+            sql::PreparedStatement statement(connection,
+                "select name from short order by rowid;");
+            sql::Results results(statement<<sql::execute);
+            results.fetch_size(rows).bind_strings(bound);
+            sql::string name;
+            assert((results >> sql::row) && (results >> name));
+            assert(name.length() == 3);
+            assert((results >> sql::row) && (results >> name));
+            assert(name.length() == longer.length());
+            assert((results >> sql::row) && (results >> name));
+            assert(name.length() == 3);
+            assert(!(results >> sql::row));
+        }
+        sql::execute(connection, "drop table short;");
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table entries;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        select(connection, 1);
+        select(connection, 3);
+        select(connection, count);
+        select(connection, 4*count);
+        mismatch(connection);
+        overflow(connection, false, 1);
+        overflow(connection, false, count);
+        overflow(connection, true, 1);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
@@ -0,0 +1,137 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+
+namespace {
+
+    const sql::int32 count = 1000;
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table entries ( id integer, name varchar(32) );");
+    }
+
+    void load (sql::Connection& connection)
+    {
+        std::cerr << "Loading " << count << " rows." << std::endl;
+        sql::BulkLoader loader(connection,
+            "insert into entries ( id, name ) values (?, ?);", 64, 0, 4);
+        for ( sql::int32 i = 0; (i < count); ++i )
+        {
+            const sql::string name(std::string(i%32+1, 'x'));
+            loader << i << name << sql::row;
+            assert(loader.pending() == sql::size_t((i+1) % 64));
+        }
+        loader.finish();
+        assert(loader.loaded() == count);
+        assert(connection.autocommit());
+    }
+
+    void bytes (sql::Connection& connection)
+    {
+        std::cerr << "Flushing on the number of bytes." << std::endl;
+            // Each row uses 4+10 bytes: flush every 10 rows.
+        sql::BulkLoader loader(connection,
+            "insert into entries ( id, name ) values (?, ?);", 1000, 140, 1);
+        for ( sql::int32 i = 0; (i < 25); ++i )
+        {
+            loader << (count+i) << sql::string("0123456789") << sql::row;
+            assert(loader.pending() == sql::size_t((i+1) % 10));
+            assert(loader.loaded() == sql::size_t((i+1) / 10 * 10));
+        }
+            // Not finished: the last 5 rows are rolled back.
+    }
+
+    void caller (sql::Connection& connection)
+    {
+        std::cerr << "Loading in the caller's transaction." << std::endl;
+        connection.disable_autocommit();
+        {
+            sql::BulkLoader loader(connection,
+                "insert into entries ( id, name ) values (?, ?);", 10, 0, 1);
+            for ( sql::int32 i = 0; (i < 25); ++i ) {
+                loader << (2*count+i) << sql::string("z") << sql::row;
+            }
+            loader.finish();
+            assert(loader.loaded() == 25);
+            assert(!connection.autocommit());
+        }
+        connection.rollback();
+        connection.enable_autocommit();
+    }
+
+    void cancel (sql::Connection& connection)
+    {
+        std::cerr << "Rolling back an unfinished load." << std::endl;
+        sql::BulkLoader loader(connection,
+            "insert into entries ( id, name ) values (?, ?);", 10, 0, 100);
+        for ( sql::int32 i = 0; (i < 25); ++i ) {
+            loader << (count+i) << sql::string("y") << sql::row;
+        }
+    }
+
+    void check (sql::Connection& connection)
+    {
+        sql::PreparedStatement statement(connection,
+            "select count(*) from entries;");
+        sql::Results results(statement<<sql::execute);
+        sql::int32 rows = 0;
+        assert(results >> sql::row >> rows);
+        assert(rows == count+20);
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table entries;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        load(connection);
+        cancel(connection);
+        bytes(connection);
+        caller(connection);
+        check(connection);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
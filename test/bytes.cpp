@@ -0,0 +1,129 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    const sql::size_t length = 1000;
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table blobs ( id integer, data blob );");
+        sql::PreparedStatement statement(connection,
+            "insert into blobs ( id, data ) values (?, ?);");
+        std::vector<unsigned char> data(length);
+        for ( sql::size_t i = 0; (i < length); ++i ) {
+            data[i] = static_cast<unsigned char>(i % 256);
+        }
+        statement << sql::int32(1)
+                  << sql::Bytes(&data[0], data.size()) << sql::execute;
+        statement << sql::int32(2) << sql::null << sql::execute;
+    }
+
+    void select (sql::Connection& connection)
+    {
+        std::cerr << "Reading into a caller buffer." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "select id, data from blobs order by id;");
+        sql::Results results(statement<<sql::execute);
+        std::vector<unsigned char> buffer(2*length);
+        sql::Bytes bytes(&buffer[0], buffer.size(), 0);
+        sql::int32 id = -1;
+        assert(results >> sql::row >> id >> bytes);
+        assert((id == 1) && !bytes.null() && (bytes.size() == length));
+        for ( sql::size_t i = 0; (i < length); ++i ) {
+            assert(buffer[i] == static_cast<unsigned char>(i % 256));
+        }
+        assert(results >> sql::row >> id >> bytes);
+        assert((id == 2) && bytes.null() && (bytes.size() == 0));
+    }
+
+    void truncate (sql::Connection& connection)
+    {
+        std::cerr << "Reading into a short buffer." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "select data from blobs where id = 1;");
+        sql::Results results(statement<<sql::execute);
+        unsigned char buffer[16] = { 0 };
+        sql::Bytes bytes(buffer, sizeof(buffer), 0);
+        assert(results >> sql::row);
+        assert(!(results >> bytes));
+        assert(bytes.size() == sizeof(buffer));
+        assert((buffer[0] == 0) && (buffer[15] == 15));
+    }
+
+    void separate (sql::Connection& connection)
+    {
+        std::cerr << "Executing after the wrapper is gone." << std::endl;
+        const unsigned char data[] = { 1, 2, 3 };
+        {
+            sql::PreparedStatement statement(connection,
+                "insert into blobs ( id, data ) values (?, ?);");
+            statement << sql::int32(3) << sql::Bytes(data, sizeof(data));
+            statement.execute();
+        }
+        sql::PreparedStatement statement(connection,
+            "select data from blobs where id = 3;");
+        sql::Results results(statement<<sql::execute);
+        unsigned char buffer[16] = { 0 };
+        sql::Bytes bytes(buffer, sizeof(buffer), 0);
+        assert(results >> sql::row >> bytes);
+        assert(bytes.size() == sizeof(data));
+        assert(std::memcmp(buffer, data, sizeof(data)) == 0);
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table blobs;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        select(connection);
+        truncate(connection);
+        separate(connection);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
@@ -0,0 +1,135 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+#include <sstream>
+
+namespace {
+
+    const sql::size_t length = 100000;
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table documents ( id integer, body text );");
+        sql::PreparedStatement statement(connection,
+            "insert into documents ( id, body ) values (?, ?);");
+        std::string body;
+        for ( sql::size_t i = 0; (i < length); ++i ) {
+            body.push_back('a' + (i % 26));
+        }
+        statement << sql::int32(1) << sql::string(body) << sql::execute;
+        statement << sql::int32(2) << sql::null << sql::execute;
+    }
+
+    void check (const std::string& body)
+    {
+        assert(body.size() == length);
+        for ( sql::size_t i = 0; (i < length); ++i ) {
+            assert(body[i] == char('a' + (i % 26)));
+        }
+    }
+
+    void read (sql::Connection& connection, sql::size_t size)
+    {
+        std::cerr << "Reading in chunks of " << size << "." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "select id, body from documents order by id;");
+        sql::Results results(statement<<sql::execute);
+        sql::int32 id = -1;
+        assert(results >> sql::row);
+        assert(results >> id);
+        assert(id == 1);
+        {
+            sql::ColumnReader reader(results, size);
+            std::istream input(&reader);
+            std::ostringstream body;
+            body << input.rdbuf();
+            assert(!reader.null());
+            check(body.str());
+        }
+        assert(results >> sql::row);
+        assert(results >> id);
+        assert(id == 2);
+        {
+            sql::ColumnReader reader(results, size);
+            const char * data = 0;
+            assert(reader.next(data) == 0);
+            assert(reader.null());
+        }
+        assert(results);
+    }
+
+    struct Append
+    {
+        std::string& myValue;
+        Append (std::string& value) : myValue(value) {}
+        void operator() (const char * data, sql::size_t size) {
+            myValue.append(data, size);
+        }
+    };
+
+    void stream (sql::Connection& connection)
+    {
+        std::cerr << "Streaming to a callback." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "select body from documents where id = 1;");
+        sql::Results results(statement<<sql::execute);
+        std::string body;
+        assert(results >> sql::row);
+        assert(sql::stream(results, Append(body), 4096));
+        check(body);
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table documents;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        read(connection, 2);
+        read(connection, 1000);
+        read(connection, 2*length);
+        stream(connection);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
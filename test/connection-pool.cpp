@@ -0,0 +1,141 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    // Allocated but never connected: enough to exercise the pool.
+    class Idle :
+        public sql::Connection
+    {
+    public:
+        explicit Idle (sql::Environment& environment)
+            : sql::Connection(environment)
+        {}
+    };
+
+    void limits (sql::Environment& environment)
+    {
+        std::cerr << "Leasing up to the limit." << std::endl;
+        int opened = 0;
+        sql::ConnectionPool pool([&] () -> sql::Connection* {
+            ++opened; return (new Idle(environment));
+        }, 1, 2);
+        pool.validate_after(3600);
+        assert((pool.size() == 1) && (pool.idle() == 1) && (opened == 1));
+        {
+            sql::ConnectionPool::Lease first = pool.acquire();
+            sql::ConnectionPool::Lease second = pool.acquire();
+            assert((pool.size() == 2) && (pool.idle() == 0));
+            sql::ConnectionPool::Lease third;
+            assert(!pool.try_acquire(third));
+            assert(!pool.try_acquire(third, std::chrono::milliseconds(10)));
+            assert(!third.valid());
+            second.discard();
+        }
+        assert((pool.size() == 1) && (pool.idle() == 1) && (opened == 2));
+        sql::ConnectionPool::Lease lease;
+        assert(pool.try_acquire(lease) && lease.valid());
+        assert(opened == 2);
+    }
+
+    void waiting (sql::Environment& environment)
+    {
+        std::cerr << "Waiting for a connection." << std::endl;
+        sql::ConnectionPool pool([&] () -> sql::Connection* {
+            return (new Idle(environment));
+        }, 0, 1);
+        pool.validate_after(3600);
+        sql::ConnectionPool::Lease lease = pool.acquire();
+        std::thread other([&lease] () {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            lease.release();
+        });
+        sql::ConnectionPool::Lease next;
+        assert(pool.try_acquire(next, std::chrono::seconds(10)));
+        other.join();
+        assert(pool.size() == 1);
+    }
+
+    void minimum (sql::Environment& environment)
+    {
+        std::cerr << "Keeping the minimum number open." << std::endl;
+        int opened = 0;
+        sql::ConnectionPool pool([&] () -> sql::Connection* {
+            ++opened; return (new Idle(environment));
+        }, 2, 4);
+        pool.validate_after(3600);
+        {
+            sql::ConnectionPool::Lease first = pool.acquire();
+            sql::ConnectionPool::Lease second = pool.acquire();
+            first.discard();
+            second.discard();
+        }
+        assert((pool.size() == 2) && (pool.idle() == 2) && (opened == 4));
+    }
+
+    void lifetime (sql::Environment& environment)
+    {
+        std::cerr << "Recycling old connections." << std::endl;
+        int opened = 0;
+        sql::ConnectionPool pool([&] () -> sql::Connection* {
+            ++opened; return (new Idle(environment));
+        }, 1, 4);
+        pool.validate_after(3600);
+        pool.max_lifetime(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+        {
+            sql::ConnectionPool::Lease lease = pool.acquire();
+        }
+        assert((opened == 2) && (pool.size() == 1));
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        sql::Environment environment;
+        limits(environment);
+        waiting(environment);
+        minimum(environment);
+        lifetime(environment);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
@@ -0,0 +1,148 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+
+#if (defined(SQLXX_COROUTINES))
+
+#include <exception>
+#include <future>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+    const sql::int32 count = 10;
+
+    // Minimal coroutine type: runs eagerly and reports completion.
+    struct Task
+    {
+        struct promise_type
+        {
+            std::promise<void> done;
+
+            Task get_return_object () {
+                return (Task{done.get_future()});
+            }
+
+            std::suspend_never initial_suspend () noexcept {
+                return {};
+            }
+
+            std::suspend_never final_suspend () noexcept {
+                return {};
+            }
+
+            void return_void () {
+                done.set_value();
+            }
+
+            void unhandled_exception () {
+                done.set_exception(std::current_exception());
+            }
+        };
+
+        std::future<void> future;
+    };
+
+    Task create (sql::Connection& connection)
+    {
+        std::unique_ptr<sql::PreparedStatement> statement =
+            co_await sql::async::prepare(connection,
+                "create table entries ( id integer );");
+        co_await sql::async::execute(*statement);
+        statement = co_await sql::async::prepare(connection,
+            "insert into entries ( id ) values (?);");
+        for ( sql::int32 i = 0; (i < count); ++i )
+        {
+            *statement << i;
+            co_await sql::async::execute(*statement);
+        }
+    }
+
+    Task select (sql::Connection& connection, sql::size_t rows)
+    {
+        std::unique_ptr<sql::PreparedStatement> statement =
+            co_await sql::async::prepare(connection,
+                "select id from entries order by id;");
+        co_await sql::async::execute(*statement);
+        sql::Results results(*statement);
+        sql::Rows<sql::int32> reader = results.as<sql::int32>();
+        std::vector< std::tuple<sql::int32> > batch;
+        sql::int32 i = 0;
+        while (co_await sql::async::fetch(reader, batch, rows) > 0)
+        {
+            assert(batch.size() <= std::size_t(rows));
+            for ( std::size_t j = 0; (j < batch.size()); ++j, ++i ) {
+                assert(std::get<0>(batch[j]) == i);
+            }
+        }
+        assert(i == count);
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table entries;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        std::cerr << "Creating rows." << std::endl;
+        create(connection).future.get();
+        std::cerr << "Reading rows, 3 at a time." << std::endl;
+        select(connection, 3).future.get();
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#else
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    {
+        std::cerr << "Coroutines are not supported: skipped." << std::endl;
+        return (EXIT_SUCCESS);
+    }
+
+}
+
+#endif
+
+#include "unit-test.cpp"
@@ -0,0 +1,93 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+
+namespace {
+
+    const sql::int32 count = 10;
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table entries ( id integer );");
+    }
+
+    void insert (sql::Connection& connection)
+    {
+        std::cerr << "Waiting for executions." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "insert into entries ( id ) values (?);");
+        for ( sql::int32 i = 0; (i < count); ++i )
+        {
+            statement << i;
+            sql::Execution execution(statement);
+            execution.wait();
+            assert(execution.ready() && !statement.executing());
+        }
+    }
+
+    void select (sql::Connection& connection)
+    {
+        std::cerr << "Polling an execution." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "select count(*) from entries;");
+        sql::Execution execution(statement);
+        while (!execution.ready()) {
+        }
+        sql::Results results(statement);
+        sql::int32 total = 0;
+        assert(results >> sql::row >> total);
+        assert(total == count);
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table entries;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        insert(connection);
+        select(connection);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
@@ -0,0 +1,120 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+
+namespace {
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table entries"
+            " ( id integer, parent integer, name varchar(32) );");
+    }
+
+    void insert (sql::Connection& connection)
+    {
+        std::cerr << "Binding by name." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "insert into entries ( id, parent, name )"
+            " values (:id, :id, @name);");
+        assert(statement.parameter_count() == 3);
+        assert(statement.has_parameter("id"));
+        assert(statement.has_parameter("name"));
+        assert(!statement.has_parameter("parent"));
+        for ( sql::int32 i = 0; (i < 5); ++i )
+        {
+            statement.bind("name", sql::string("x"));
+            statement.bind("id", i);
+            statement.execute();
+        }
+    }
+
+    void select (sql::Connection& connection)
+    {
+        sql::PreparedStatement statement(connection,
+            "select count(*) from entries"
+            " where id = parent and name = ':id' or id >= :low;");
+        assert(statement.parameter_count() == 1);
+        statement.bind("low", sql::int32(0));
+        sql::Results results(statement << sql::execute);
+        sql::int32 count = 0;
+        assert(results >> sql::row >> count);
+        assert(count == 5);
+    }
+
+    void variables (sql::Connection& connection)
+    {
+        std::cerr << "Leaving variables alone." << std::endl;
+        typedef sql::PreparedStatement Statement;
+        assert(Statement::positional("select @@identity;")
+               == "select @@identity;");
+        assert(Statement::positional("select @@ROWCOUNT, @id;")
+               == "select @@ROWCOUNT, ?;");
+        assert(Statement::positional("declare @x int; set @x = :y;")
+               == "declare @x int; set @x = ?;");
+        assert(Statement::positional("SET @total = 0;")
+               == "SET @total = 0;");
+        assert(Statement::positional("select @a, ? from t;")
+               == "select @a, ? from t;");
+        assert(Statement::positional("select @a from settings;")
+               == "select ? from settings;");
+
+            // SQLite also supports "@name": both are passed through.
+        sql::PreparedStatement statement(connection,
+            "select count(*) from entries where id >= ? or id = @x;");
+        assert(statement.parameter_count() == 2);
+        assert(!statement.has_parameter("x"));
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table entries;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        insert(connection);
+        select(connection);
+        variables(connection);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
@@ -0,0 +1,117 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+#include <cstring>
+
+namespace {
+
+    bool same (const sql::string& value, const char * expected)
+    {
+        const std::size_t length = std::strlen(expected);
+        return ((std::size_t(value.length()) == length) &&
+                (std::memcmp(value.data(), expected, length) == 0));
+    }
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table entries ( id integer, name varchar(32) );");
+    }
+
+    void bind (sql::Connection& connection)
+    {
+        std::cerr << "Binding output parameters." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "insert into entries ( id, name ) values (?, ?);");
+        sql::int32 id = 0;
+        sql::string name("ignored");
+        const sql::Output<sql::int32> first = sql::out(id);
+        const sql::Output<sql::string> second = sql::out(name, 16);
+        assert(first.null() && second.null());
+        statement << first << second;
+        assert(first.null() && second.null());
+        statement.reset();
+    }
+
+    void inout (sql::Connection& connection)
+    {
+            // SQLite has no procedures: the values are only sent.  The
+            // wrappers are gone by the time the statement executes.
+        std::cerr << "Sending input/output parameters." << std::endl;
+        sql::int32 id = 7;
+        sql::string name("seven");
+        sql::string other("eight");
+        {
+            sql::PreparedStatement statement(connection,
+                "insert into entries ( id, name ) values (?, ?);");
+            statement << sql::inout(id) << sql::inout(name);
+            statement.execute();
+            statement.read_outputs();
+            assert((id == 7) && same(name, "seven"));
+
+            const sql::Output<sql::string> output = sql::inout(other);
+            statement << sql::int32(8) << output << sql::execute;
+            assert(!output.null() && same(other, "eight"));
+        }
+        sql::PreparedStatement statement(connection,
+            "select id, name from entries order by id;");
+        sql::Results results(statement<<sql::execute);
+        sql::int32 value = 0;
+        sql::string text;
+        assert(results >> sql::row >> value >> text);
+        assert((value == 7) && same(text, "seven"));
+        assert(results >> sql::row >> value >> text);
+        assert((value == 8) && same(text, "eight"));
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table entries;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        bind(connection);
+        inout(connection);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
@@ -0,0 +1,111 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+#include <vector>
+
+namespace {
+
+    const sql::int32 count = 100;
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table entries ( id integer, name varchar(32), ratio double );");
+    }
+
+    void insert (sql::Connection& connection)
+    {
+        std::cerr << "Inserting " << count << " rows at once." << std::endl;
+        std::vector<sql::int32> ids;
+        std::vector<sql::string> names;
+        std::vector<double> ratios;
+        for ( sql::int32 i = 0; (i < count); ++i )
+        {
+            ids.push_back(i);
+            names.push_back(sql::string(std::string(i%32+1, 'x')));
+            ratios.push_back(i * 0.5);
+        }
+        sql::PreparedStatement statement(connection,
+            "insert into entries ( id, name, ratio ) values (?, ?, ?);");
+        statement << ids << names << ratios << sql::execute;
+        assert(statement.rows_processed() == count);
+        for ( sql::int32 i = 0; (i < count); ++i ) {
+            assert(statement.row_succeeded(i));
+        }
+
+            // Single values can be bound again after a bulk execution.
+        statement << count << sql::string("y") << 0.0 << sql::execute;
+    }
+
+    void select (sql::Connection& connection)
+    {
+        sql::PreparedStatement statement(connection,
+            "select id, name, ratio from entries order by id;");
+        sql::Results results(statement<<sql::execute);
+        sql::int32 i = 0;
+        for ( ; (results >> sql::row); ++i )
+        {
+            sql::int32 id = -1;
+            sql::string name;
+            double ratio = -1.0;
+            assert(results >> id >> name >> ratio);
+            assert(id == i);
+            if (i < count) {
+                assert(name.length() == i%32+1);
+                assert(ratio == i * 0.5);
+            }
+        }
+        assert(i == count+1);
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table entries;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        insert(connection);
+        select(connection);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
@@ -0,0 +1,146 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+    const sql::int32 count = 10;
+
+    struct Entry
+    {
+        sql::int32 id;
+        sql::string name;
+    };
+
+}
+
+namespace sql {
+
+    template<> struct row_traits< ::Entry >
+    {
+        typedef std::tuple<sql::int32, sql::string> columns;
+    };
+
+}
+
+namespace {
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table entries ( id integer, name varchar(32) );");
+        sql::PreparedStatement statement(connection,
+            "insert into entries ( id, name ) values (?, ?);");
+        for ( sql::int32 i = 0; (i < count); ++i ) {
+            sql::execute(statement, i, sql::string(std::string(i+1, 'x')));
+        }
+    }
+
+    void arity (sql::Connection& connection)
+    {
+        std::cerr << "Checking the number of values." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "insert into entries ( id, name ) values (?, ?);");
+        try {
+            sql::execute(statement, sql::int32(0));
+            assert(false);
+        }
+        catch ( const std::invalid_argument& ) {}
+    }
+
+    void tuples (sql::Connection& connection)
+    {
+        std::cerr << "Querying tuples." << std::endl;
+        typedef std::tuple<sql::int32, sql::string> Row;
+        sql::PreparedStatement statement(connection,
+            "select id, name from entries where id >= ? order by id;");
+        const std::vector<Row> rows =
+            sql::query<Row>(statement, sql::int32(4));
+        assert(rows.size() == std::size_t(count-4));
+        for ( std::size_t i = 0; (i < rows.size()); ++i )
+        {
+            assert(std::get<0>(rows[i]) == sql::int32(i+4));
+            assert(std::get<1>(rows[i]).length() == sql::size_t(i+5));
+        }
+    }
+
+    void structs (sql::Connection& connection)
+    {
+        std::cerr << "Querying structures." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "select id, name from entries order by id;");
+        const std::vector<Entry> entries = sql::query<Entry>(statement);
+        assert(entries.size() == std::size_t(count));
+        assert((entries[2].id == 2) && (entries[2].name.length() == 3));
+    }
+
+    void complete (sql::Connection& connection)
+    {
+        std::cerr << "Querying values longer than their column." << std::endl;
+        sql::PreparedStatement insert(connection,
+            "insert into entries ( id, name ) values (?, ?);");
+        sql::execute(insert, count, sql::string(std::string(100, 'z')));
+        sql::PreparedStatement statement(connection,
+            "select id, name from entries where id >= ? order by id;");
+        const std::vector<Entry> entries =
+            sql::query<Entry>(statement, sql::int32(count-1));
+        assert(entries.size() == 2);
+        assert(entries[1].name.length() == 100);
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table entries;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        arity(connection);
+        tuples(connection);
+        structs(connection);
+        complete(connection);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
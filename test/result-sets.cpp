@@ -0,0 +1,108 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+#include <algorithm>
+
+namespace {
+
+    const sql::int32 count = 5;
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table entries ( id integer, name varchar(32) );");
+        sql::PreparedStatement statement(connection,
+            "insert into entries ( id, name ) values (?, ?);");
+        for ( sql::int32 i = 0; (i < count); ++i ) {
+            statement << i << sql::string(std::string(i+1, 'x'))
+                      << sql::execute;
+        }
+    }
+
+    void select (sql::Connection& connection, sql::int32 first)
+    {
+        std::cerr
+            << "Reading " << first << " row(s) of the first result set."
+            << std::endl;
+        sql::PreparedStatement statement(connection,
+            "select id from entries order by id;"
+            " select name, id from entries order by id desc;");
+        sql::Results results(statement<<sql::execute);
+        results.fetch_size(2);
+        sql::int32 i = 0;
+        for ( ; (i < first) && (results >> sql::row); ++i )
+        {
+            sql::int32 id = -1;
+            assert(results >> id);
+            assert(id == i);
+        }
+        assert(i == std::min(first, count));
+        if (first > count) {
+            assert(!results);
+        }
+
+            // Different layout: bindings and types are learned again.
+        assert(results.next_result_set());
+        assert(results);
+        for ( i = count-1; (results >> sql::row); --i )
+        {
+            sql::string name;
+            sql::int32 id = -1;
+            assert(results >> name >> id);
+            assert((id == i) && (name.length() == i+1));
+        }
+        assert(i == -1);
+        assert(!results.next_result_set());
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table entries;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        select(connection, count+1);
+        select(connection, 1);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
@@ -0,0 +1,152 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+
+namespace {
+
+    const sql::int32 count = 10;
+
+    struct Entry
+    {
+        sql::int32 id;
+        sql::string name;
+        double ratio;
+    };
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table entries ( id integer, name varchar(32), ratio double );");
+        sql::PreparedStatement statement(connection,
+            "insert into entries ( id, name, ratio ) values (?, ?, ?);");
+        for ( sql::int32 i = 0; (i < count); ++i )
+        {
+            const sql::string name(std::string(i+1, 'x'));
+            const double ratio = i * 0.5;
+            statement << i << name << ratio << sql::execute;
+        }
+        statement << count << sql::null << sql::null << sql::execute;
+    }
+
+    void tuples (sql::Connection& connection, sql::size_t rows)
+    {
+        std::cerr << "Reading tuples, " << rows << " at a time." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "select id, name, ratio from entries order by id;");
+        sql::Results results(statement<<sql::execute);
+        sql::Rows<sql::int32, sql::string, double> reader =
+            results.as<sql::int32, sql::string, double>(rows);
+        std::tuple<sql::int32, sql::string, double> row;
+        sql::int32 i = 0;
+        for ( ; (i < count) && (reader >> row); ++i )
+        {
+            assert(std::get<0>(row) == i);
+            assert(std::get<1>(row).length() == i+1);
+            assert(std::get<2>(row) == i * 0.5);
+        }
+        assert(i == count);
+        assert(reader >> row);
+        assert(reader.null(1) && reader.null(2));
+        assert((std::get<1>(row).length() == 0) && (std::get<2>(row) == 0.0));
+        assert(!(reader >> row));
+    }
+
+    void structs (sql::Connection& connection)
+    {
+        std::cerr << "Reading structures." << std::endl;
+        sql::PreparedStatement statement(connection,
+            "select id, name, ratio from entries where id < ? order by id;");
+        sql::Results results(statement << count << sql::execute);
+        sql::Rows<sql::int32, sql::string, double> reader(results, 4);
+        Entry entry;
+        sql::int32 i = 0;
+        for ( ; (reader >> entry); ++i )
+        {
+            assert(entry.id == i);
+            assert(entry.name.length() == i+1);
+            assert(entry.ratio == i * 0.5);
+        }
+        assert(i == count);
+    }
+
+    void overflow (sql::Connection& connection)
+    {
+        std::cerr << "Reading values longer than their column." << std::endl;
+            // The declared size is only a hint for some drivers (SQLite).
+        const std::string text(100, 'y');
+        sql::execute(connection,
+            "create table overflow ( id integer, name varchar(8) );");
+        sql::PreparedStatement insert(connection,
+            "insert into overflow ( id, name ) values (?, ?);");
+        for ( sql::int32 i = 0; (i < 3); ++i ) {
+            insert << i << sql::string(text) << sql::execute;
+        }
+        sql::PreparedStatement statement(connection,
+            "select id, name from overflow order by id;");
+        sql::Results results(statement<<sql::execute);
+        sql::Rows<sql::int32, sql::string> reader(results, 2);
+        std::tuple<sql::int32, sql::string> row;
+        sql::int32 i = 0;
+        for ( ; (reader >> row); ++i )
+        {
+            assert(std::get<0>(row) == i);
+            assert(std::get<1>(row).length() == sql::size_t(text.size()));
+        }
+        assert(i == 3);
+        sql::execute(connection, "drop table overflow;");
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table entries;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        tuples(connection, 1);
+        tuples(connection, 3);
+        tuples(connection, 4*count);
+        structs(connection);
+        overflow(connection);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
@@ -0,0 +1,107 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+
+namespace {
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table entries ( id integer, name varchar(32) );");
+    }
+
+    void cache (sql::Connection& connection)
+    {
+        std::cerr << "Reusing prepared statements." << std::endl;
+        sql::StatementCache statements(connection, 2);
+        const sql::string insert =
+            "insert into entries ( id, name ) values (?, ?);";
+        const sql::string select = "select count(*) from entries;";
+        const sql::string remove = "delete from entries;";
+        for ( sql::int32 i = 0; (i < 10); ++i ) {
+            statements.prepare(insert)
+                << i << sql::string("x") << sql::execute;
+        }
+        assert((statements.hits() == 9) && (statements.misses() == 1));
+
+        sql::int32 count = 0;
+        {
+            sql::Results results(statements.prepare(select) << sql::execute);
+            assert(results >> sql::row >> count);
+            assert(count == 10);
+        }
+        assert(statements.size() == 2);
+
+            // Stop after the first row, leaving the cursor open.
+        const sql::string ordered = "select id from entries order by id;";
+        for ( sql::int32 i = 0; (i < 2); ++i )
+        {
+            sql::Results results(statements.prepare(ordered) << sql::execute);
+            sql::int32 id = -1;
+            assert(results >> sql::row >> id);
+            assert(id == 0);
+        }
+        assert((statements.hits() == 10) && (statements.misses() == 3));
+
+            // Evicts the count statement (least recently used).
+        statements.prepare(remove) << sql::execute;
+        assert(statements.size() == 2);
+        statements.prepare(insert) << 0 << sql::string("y") << sql::execute;
+        assert((statements.hits() == 10) && (statements.misses() == 5));
+
+        statements.invalidate(remove);
+        assert(statements.size() == 1);
+        statements.invalidate();
+        assert(statements.size() == 0);
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table entries;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        cache(connection);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
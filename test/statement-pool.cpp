@@ -0,0 +1,105 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+
+namespace {
+
+    void reuse (sql::Connection& connection)
+    {
+        std::cerr << "Reusing statement handles." << std::endl;
+        connection.release_statements();
+        sql::execute(connection, "create table entries ( id integer );");
+        assert(connection.idle_statements() == 1);
+        for ( int i = 0; (i < 100); ++i ) {
+            sql::execute(connection, "insert into entries values (1);");
+        }
+        assert(connection.idle_statements() == 1);
+        {
+            sql::PreparedStatement first(connection,
+                "select count(*) from entries;");
+            sql::PreparedStatement second(connection,
+                "select count(*) from entries;");
+            assert(connection.idle_statements() == 0);
+            sql::Results results(first<<sql::execute);
+            sql::int32 count = 0;
+            assert(results >> sql::row >> count);
+            assert(count == 100);
+        }
+        assert(connection.idle_statements() == 2);
+    }
+
+    void synchronous (sql::Connection& connection)
+    {
+        std::cerr << "Reusing an asynchronous statement handle." << std::endl;
+        {
+            sql::PreparedStatement statement(connection,
+                "select count(*) from entries;");
+            statement.asynchronous(true);
+        }
+        assert(connection.idle_statements() == 2);
+
+            // Gets the same handle back, which must be synchronous again.
+        sql::PreparedStatement statement(connection,
+            "select count(*) from entries;");
+        sql::Results results(statement<<sql::execute);
+        sql::int32 count = 0;
+        assert(results >> sql::row >> count);
+        assert(count == 100);
+    }
+
+    void limit (sql::Connection& connection)
+    {
+        std::cerr << "Limiting idle statement handles." << std::endl;
+        connection.pool_statements(1);
+        assert(connection.idle_statements() == 1);
+        connection.pool_statements(0);
+        assert(connection.idle_statements() == 0);
+        sql::execute(connection, "drop table entries;");
+        assert(connection.idle_statements() == 0);
+        connection.pool_statements(16);
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        reuse(connection);
+        synchronous(connection);
+        limit(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
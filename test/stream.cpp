@@ -0,0 +1,125 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "unit-test.hpp"
+#include <sstream>
+#include <vector>
+
+namespace {
+
+    const sql::size_t length = 200000;
+
+    // Produces the value in pieces, as a generator would.
+    struct Counter
+    {
+        sql::size_t next;
+
+        sql::size_t operator() (char * data, sql::size_t size)
+        {
+            sql::size_t count = 0;
+            for ( ; (count < size) && (next < length); ++count, ++next ) {
+                data[count] = static_cast<char>(next % 256);
+            }
+            return (count);
+        }
+    };
+
+    void create (sql::Connection& connection)
+    {
+        sql::execute(connection,
+            "create table blobs ( id integer, data blob );");
+    }
+
+    void insert (sql::Connection& connection)
+    {
+        std::cerr << "Streaming parameters." << std::endl;
+        std::string text(length, '\0');
+        for ( sql::size_t i = 0; (i < length); ++i ) {
+            text[i] = static_cast<char>(i % 256);
+        }
+        std::istringstream stream(text);
+        Counter counter = { 0 };
+        sql::PreparedStatement statement(connection,
+            "insert into blobs ( id, data ) values (?, ?);");
+        statement << sql::int32(1) << sql::Stream(stream, length)
+                  << sql::execute;
+            // The wrapper is gone by the time the statement executes.
+        statement << sql::int32(2) << sql::Stream(counter);
+        statement.execute();
+        std::istringstream empty;
+        statement << sql::int32(3) << sql::Stream(empty)
+                  << sql::execute;
+    }
+
+    void select (sql::Connection& connection)
+    {
+        sql::PreparedStatement statement(connection,
+            "select id, data from blobs order by id;");
+        sql::Results results(statement<<sql::execute);
+        std::vector<unsigned char> buffer(length+1);
+        for ( sql::int32 expected = 1; (expected <= 2); ++expected )
+        {
+            sql::Bytes bytes(&buffer[0], buffer.size(), 0);
+            sql::int32 id = -1;
+            assert(results >> sql::row >> id >> bytes);
+            assert((id == expected) && (bytes.size() == length));
+            for ( sql::size_t i = 0; (i < length); ++i ) {
+                assert(buffer[i] == static_cast<unsigned char>(i % 256));
+            }
+        }
+        sql::Bytes bytes(&buffer[0], buffer.size(), 0);
+        sql::int32 id = -1;
+        assert(results >> sql::row >> id >> bytes);
+        assert((id == 3) && !bytes.null() && (bytes.size() == 0));
+    }
+
+    void drop (sql::Connection& connection)
+    {
+        sql::execute(connection, "drop table blobs;");
+    }
+
+}
+
+namespace {
+
+    int test (sql::Connection& connection, int argc, char ** argv)
+    try
+    {
+        create(connection);
+        insert(connection);
+        select(connection);
+        drop(connection);
+        return (EXIT_SUCCESS);
+    }
+    catch ( ... ) {
+        std::cerr << "Something failed." << std::endl;
+        //drop(connection);
+        throw;
+    }
+
+}
+
+#include "unit-test.cpp"
@@ -0,0 +1,150 @@
+// Copyright (c) 2009-2012, Andre Caron (andre.l.caron@gmail.com)
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Compares the cost of obtaining a connection with and without pooling:
+//
+//   1. connect and disconnect every time;
+//   2. the same, with driver manager pooling enabled;
+//   3. leases from an sql::ConnectionPool;
+//   4. leases from an sql::AffinityPool over the same.
+//
+// Usage: pool-benchmark filepath [iterations]
+//
+// With unixODBC, driver manager pooling also needs "Pooling = Yes" in the
+// [ODBC] section of odbcinst.ini and a "CPTimeout" for the SQLite driver;
+// otherwise (2) shows the same cost as (1).
+
+#include <sql.hpp>
+#include "sqlite.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+    typedef std::chrono::steady_clock Clock;
+
+    void report (const char * name, int iterations, Clock::duration elapsed)
+    {
+        const double total = std::chrono::duration_cast<
+            std::chrono::duration<double, std::micro> >(elapsed).count();
+        std::cout
+            << std::left << std::setw(16) << name << std::right
+            << std::fixed << std::setprecision(1)
+            << std::setw(12) << (total / 1000.0) << " ms"
+            << std::setw(12) << (total / iterations) << " us/connection"
+            << std::endl;
+    }
+
+    void measure (const char * name, int iterations,
+                  const std::function<void()>& connect)
+    {
+            // Warm up, so that first-time costs (loading the driver,
+            // filling the pools) are not counted.
+        connect();
+        const Clock::time_point start = Clock::now();
+        for (int i = 0; (i < iterations); ++i) {
+            connect();
+        }
+        report(name, iterations, Clock::now()-start);
+    }
+
+    void raw (const sql::string& filepath, int iterations)
+    {
+        sql::Environment environment(sql::Pooling::off);
+        measure("raw", iterations, [&] () {
+            sql::sqlite::Connection connection(environment, filepath);
+        });
+    }
+
+    void driver_manager (const sql::string& filepath, int iterations)
+    {
+        sql::Environment environment(sql::Pooling::per_driver);
+        measure("driver manager", iterations, [&] () {
+            sql::sqlite::Connection connection(environment, filepath);
+        });
+    }
+
+    void sqlxx (const sql::string& filepath, int iterations)
+    {
+        sql::Environment environment(sql::Pooling::off);
+        sql::ConnectionPool pool([&] () -> sql::Connection* {
+            return (new sql::sqlite::Connection(environment, filepath));
+        }, 1, 1);
+        measure("sqlxx", iterations, [&] () {
+            sql::ConnectionPool::Lease lease = pool.acquire();
+        });
+        sql::AffinityPool cache(pool);
+        measure("sqlxx affinity", iterations, [&] () {
+            sql::AffinityPool::Lease lease = cache.acquire();
+        });
+    }
+
+}
+
+int main ( int argc, char ** argv )
+try
+{
+    if ((argc < 2) || (argc > 3))
+    {
+        std::cerr
+            << "Usage: " << argv[0] << " filepath [iterations]"
+            << std::endl;
+        return (EXIT_FAILURE);
+    }
+    const sql::string filepath(argv[1]);
+    const int iterations = (argc > 2)? std::atoi(argv[2]) : 1000;
+    if (iterations < 1)
+    {
+        std::cerr
+            << "Invalid iteration count: '" << argv[2] << "'." << std::endl;
+        return (EXIT_FAILURE);
+    }
+
+        // Pooling is process-wide: measure without it first.
+    raw(filepath, iterations);
+    driver_manager(filepath, iterations);
+    sqlxx(filepath, iterations);
+    return (EXIT_SUCCESS);
+}
+catch ( const sql::Diagnostic& diagnostic ) {
+    std::cerr << diagnostic << std::endl;
+    return (EXIT_FAILURE);
+}
+catch ( const sql::Environment::Failure& ) {
+    std::cerr << "Failed to initialize SQL/ODBC environment!" << std::endl;
+    return (EXIT_FAILURE);
+}
+catch ( const std::exception& error ) {
+    std::cerr << error.what() << std::endl;
+    return (EXIT_FAILURE);
+}
+catch ( ... ) {
+    std::cerr << "Unknown error!" << std::endl;
+    return (EXIT_FAILURE);
+}